@@ -0,0 +1,129 @@
+#include "headers/agentBatch.h"
+#include <algorithm>
+
+/**
+ * @brief Konstruktor, legt count Spieler auf der Startposition an.
+ * @param sharedLevel geladene und gültige Karte, wird geteilt
+ * @param count Anzahl der Spieler
+ */
+AgentBatch::AgentBatch(std::shared_ptr<const Level> sharedLevel, size_t count)
+        : level(std::move(sharedLevel)), x(count), y(count), cell(count), state(count), steps(count)
+{
+    reset();
+}
+
+/**
+ * @brief Setzt alle Spieler auf die Startposition zurück.
+ */
+void AgentBatch::reset()
+{
+    PlayerState start = Physics::start(*level);
+
+    std::fill(x.begin(), x.end(), static_cast<uint32_t>(start.x));
+    std::fill(y.begin(), y.end(), static_cast<uint32_t>(start.y));
+    std::fill(cell.begin(), cell.end(), start.cell);
+    std::fill(state.begin(), state.end(), RUNNING);
+    std::fill(steps.begin(), steps.end(), 0);
+}
+
+/**
+ * @brief Ein Takt: jeder laufende Spieler führt seine Eingabe aus.
+ *
+ * Leerraum bedeutet, dass der Spieler in diesem Takt nichts tut (zählt nicht als Zug),
+ * so können Eingabefolgen verschiedener Länge zusammen abgespielt werden.
+ * Ab MIN_PARALLEL Spielern werden zusammenhängende Bereiche auf den Pool verteilt.
+ *
+ * @param inputs eine Eingabe pro Spieler, size() Zeichen
+ * @param pool Threads oder nullptr für den aufrufenden Thread
+ */
+void AgentBatch::tick(const char* inputs, ThreadPool* pool)
+{
+    size_t count = size();
+
+    if (pool == nullptr || count < MIN_PARALLEL)
+    {
+        tickRange(inputs, 0, count);
+        return;
+    }
+
+    size_t blocks = (count + BLOCK - 1) / BLOCK;
+    size_t ranges = std::min(pool->size() + 1, blocks);
+
+    pool->parallelFor(ranges, [&](size_t range) {
+        size_t first = blocks * range / ranges * BLOCK;
+        size_t last = std::min(blocks * (range + 1) / ranges * BLOCK, count);
+        tickRange(inputs, first, last);
+    });
+}
+
+/**
+ * @brief Führt die Eingaben der Spieler [first, last) aus.
+ *
+ * Fertige Spieler und Leerraum werden übersprungen, ohne den Zustand zu laden.
+ */
+void AgentBatch::tickRange(const char* inputs, size_t first, size_t last)
+{
+    const Level& map = *level;
+
+    for (size_t i = first; i < last; ++i)
+    {
+        char input = inputs[i];
+        if (state[i] != RUNNING || input == ' ' || (input >= '\t' && input <= '\r')) continue;
+
+        PlayerState agent;
+        agent.x = x[i];
+        agent.y = y[i];
+        agent.cell = cell[i];
+
+        Physics::step(map, agent, input);
+        ++steps[i];
+
+        x[i] = static_cast<uint32_t>(agent.x);
+        y[i] = static_cast<uint32_t>(agent.y);
+        cell[i] = agent.cell;
+
+        if (agent.dead)
+        {
+            state[i] = DEAD;
+        } else if (Physics::hasWon(map, agent))
+        {
+            state[i] = WON;
+        }
+    }
+}
+
+///@brief Anzahl der Spieler
+size_t AgentBatch::size() const
+{
+    return state.size();
+}
+
+///@brief Anzahl der Spieler, die weder gewonnen haben noch tot sind
+size_t AgentBatch::running() const
+{
+    return static_cast<size_t>(std::count(state.begin(), state.end(), RUNNING));
+}
+
+///@brief x-Positionen aller Spieler
+const std::vector<uint32_t>& AgentBatch::getX() const
+{
+    return x;
+}
+
+///@brief y-Positionen aller Spieler
+const std::vector<uint32_t>& AgentBatch::getY() const
+{
+    return y;
+}
+
+///@brief Zustand aller Spieler (RUNNING, WON, DEAD)
+const std::vector<uint8_t>& AgentBatch::getState() const
+{
+    return state;
+}
+
+///@brief verarbeitete Eingaben aller Spieler
+const std::vector<uint32_t>& AgentBatch::getSteps() const
+{
+    return steps;
+}
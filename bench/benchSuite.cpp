@@ -0,0 +1,324 @@
+#include "headers/level.h"
+#include "headers/map.h"
+#include "headers/mapGenerator.h"
+#include "headers/mapLoader.h"
+#include "headers/mappedFile.h"
+#include "headers/mapValidator.h"
+#include "headers/physics.h"
+#include "headers/renderer.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+/**
+ * Benchmarks für alle Stufen des Spiels, auf den Karten in maps/ und auf
+ * künstlichen Karten (MapGenerator) von 100 x 100 bis 10000 x 10000 Zellen:
+ *   parse     Textdatei einlesen (mmap, Zeilen kopieren), wie beim Laden einer Karte
+ *   validate  MapValidator::validate() auf der eingelesenen Karte
+ *   load      Level::loadText(): einlesen, prüfen, Index, Übergangstabelle, Lösung suchen
+ *   render    ein ganzes Bild mit dem Renderer nach /dev/null
+ *   step      ein Zug mit Physics::step(), wie Player::updatePosition() ohne Zeichnen
+ *
+ * Für jede Messung: Median und 99. Perzentil pro Operation und Allokationen pro
+ * Operation (globaler operator new ist ersetzt und zählt mit).
+ *
+ * Aufruf: benchSuite [--max N] [--maps ORDNER] [--json DATEI] [--compare DATEI] [--threshold PROZENT]
+ *   --max        größte künstliche Karte N x N (Standard 10000)
+ *   --maps       Ordner mit Karten (Standard maps/)
+ *   --json       Ergebnisse als JSON schreiben
+ *   --compare    mit einer früher geschriebenen JSON-Datei vergleichen
+ *   --threshold  ab wie viel Prozent langsamer (Median) eine Messung als Regression gilt (Standard 10)
+ *
+ * Rückgabe 1, wenn beim Vergleich eine Regression gefunden wurde.
+ */
+
+namespace {
+
+std::atomic<size_t> allocations{0};
+
+}
+
+void* operator new(size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const double MIN_SECONDS = 0.2; ///< so lange wird jede Messung mindestens wiederholt
+const size_t MIN_SAMPLES = 5, MAX_SAMPLES = 1000;
+
+struct Result {
+    std::string name;
+    double medianNs = 0, p99Ns = 0, allocsPerOp = 0;
+    size_t samples = 0;
+};
+
+/**
+ * @brief Misst eine Operation.
+ *
+ * Ein Messpunkt ist ein Aufruf von run, der opsPerSample Operationen ausführt.
+ * prepare wird vor jedem Messpunkt außerhalb der Zeitmessung aufgerufen.
+ */
+Result measure(const std::string& name, size_t opsPerSample, const std::function<void()>& prepare,
+               const std::function<void()>& run)
+{
+    std::vector<double> perOp;
+    size_t allocated = 0;
+    double total = 0;
+
+    while (perOp.size() < MAX_SAMPLES && (perOp.size() < MIN_SAMPLES || total < MIN_SECONDS))
+    {
+        prepare();
+
+        size_t allocationsBefore = allocations.load(std::memory_order_relaxed);
+        auto start = std::chrono::steady_clock::now();
+        run();
+        std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+        allocated += allocations.load(std::memory_order_relaxed) - allocationsBefore;
+
+        total += seconds.count();
+        perOp.push_back(seconds.count() * 1e9 / static_cast<double>(opsPerSample));
+    }
+
+    std::sort(perOp.begin(), perOp.end());
+
+    Result result;
+    result.name = name;
+    result.samples = perOp.size();
+    result.medianNs = perOp[perOp.size() / 2];
+    result.p99Ns = perOp[std::min(perOp.size() - 1, perOp.size() * 99 / 100)];
+    result.allocsPerOp = static_cast<double>(allocated) / static_cast<double>(perOp.size() * opsPerSample);
+
+    std::printf("%-32s %14.1f %14.1f %10.2f %8zu\n", name.c_str(), result.medianNs, result.p99Ns,
+                result.allocsPerOp, result.samples);
+    std::fflush(stdout);
+
+    return result;
+}
+
+///@brief Schreibt eine künstliche Karte size x size mit MapGenerator, immer mit demselben Seed
+void writeSyntheticMap(const std::string& path, size_t size)
+{
+    GeneratorOptions options;
+    options.width = size;
+    options.height = size;
+    options.laddersPerLayer = std::max<size_t>(size / 40, 1);
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    MapGenerator::write(out, options);
+}
+
+///@brief Liest eine Karte ein wie Level::loadText(), ohne Prüfung
+bool parseMap(const std::string& path, Grid& grid)
+{
+    MappedFile file(path);
+    if (!file.isOpen()) return false;
+
+    size_t bodyOffset = 0, height = 0, width = 0;
+    std::string_view sizes = MapLoader::headerLine(file.data(), file.size(), bodyOffset);
+    size_t separator = sizes.find(' ');
+
+    if (MapLoader::parseDimension(sizes.substr(0, separator), height) != MapLoader::DimensionError::NONE
+        || MapLoader::parseDimension(sizes.substr(separator + 1), width) != MapLoader::DimensionError::NONE)
+    {
+        return false;
+    }
+
+    grid.assign(height, width, ' ');
+    MapLoader::copyRows(file.data() + bodyOffset, file.size() - bodyOffset, grid);
+    return true;
+}
+
+///@brief Alle Messungen für eine Karte
+void benchMap(const std::string& label, const std::string& path, std::vector<Result>& results)
+{
+    Grid parsed;
+    results.push_back(measure(label + "/parse", 1, [] {}, [&] { parseMap(path, parsed); }));
+
+    if (parsed.empty()) return;
+
+    Grid grid;
+    results.push_back(measure(label + "/validate", 1, [&] { grid = parsed; }, [&] {
+        MapValidator::validate(grid, ClassicRules::MAX_SPACE, ClassicRules::PLAYER_HEIGHT);
+    }));
+
+    auto level = std::make_shared<Level>();
+    LoadReport report;
+    results.push_back(measure(label + "/load", 1, [&] { *level = Level(); }, [&] {
+        report = Level::loadText(path, *level, ClassicRules::PROFILE);
+    }));
+
+    if (!report.ok()) return; //ungültige Karten kann man nicht spielen
+
+    std::shared_ptr<const Grid> shown(level, &level->grid);
+    int null = open("/dev/null", O_WRONLY);
+    Renderer renderer(null);
+
+    results.push_back(measure(label + "/render", 1, [] {}, [&] {
+        renderer.drawFrame(shown, level->startPos[1], level->startPos[0]);
+    }));
+    close(null);
+
+    //zufällige, aber feste Eingaben; tote Spieler fangen wieder am Start an
+    const size_t STEPS = 100000;
+    std::string inputs(STEPS, 'D');
+    uint32_t seed = 12345;
+    for (char& input : inputs)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        input = "ADDDF"[(seed >> 16) % 5];
+    }
+
+    results.push_back(measure(label + "/step", STEPS, [] {}, [&] {
+        PlayerState state = Physics::start(*level);
+        for (char input : inputs)
+        {
+            Physics::step(*level, state, input);
+            if (state.dead) state = Physics::start(*level);
+        }
+    }));
+}
+
+///@brief Schreibt die Ergebnisse als JSON, eine Messung pro Zeile
+bool writeJson(const std::string& path, const std::vector<Result>& results)
+{
+    std::FILE* out = std::fopen(path.c_str(), "w");
+    if (out == nullptr) return false;
+
+    std::fprintf(out, "{\n  \"results\": [\n");
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const Result& result = results[i];
+        std::fprintf(out, "    {\"name\": \"%s\", \"median_ns\": %.1f, \"p99_ns\": %.1f, \"allocs_per_op\": %.3f, \"samples\": %zu}%s\n",
+                     result.name.c_str(), result.medianNs, result.p99Ns, result.allocsPerOp, result.samples,
+                     i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(out, "  ]\n}\n");
+
+    return std::fclose(out) == 0;
+}
+
+///@brief Liest eine von writeJson() geschriebene Datei: Name -> Median
+std::map<std::string, double> readJson(const std::string& path)
+{
+    std::map<std::string, double> medians;
+    std::ifstream in(path);
+
+    for (std::string line; std::getline(in, line);)
+    {
+        size_t name = line.find("\"name\": \"");
+        size_t median = line.find("\"median_ns\": ");
+        if (name == std::string::npos || median == std::string::npos) continue;
+
+        name += 9;
+        medians[line.substr(name, line.find('"', name) - name)] = std::atof(line.c_str() + median + 13);
+    }
+
+    return medians;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    size_t maxSize = 10000;
+    double threshold = 10;
+    std::string mapDirectory = "maps/", jsonPath, comparePath;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+
+        if (i + 1 >= argc)
+        {
+            std::fprintf(stderr, "Unbekannte Option: %s\n", argument.c_str());
+            return 1;
+        }
+
+        if (argument == "--max") maxSize = std::strtoul(argv[++i], nullptr, 10);
+        else if (argument == "--maps") mapDirectory = argv[++i];
+        else if (argument == "--json") jsonPath = argv[++i];
+        else if (argument == "--compare") comparePath = argv[++i];
+        else if (argument == "--threshold") threshold = std::atof(argv[++i]);
+        else {
+            std::fprintf(stderr, "Unbekannte Option: %s\n", argument.c_str());
+            return 1;
+        }
+    }
+
+    std::vector<Result> results;
+    std::printf("%-32s %14s %14s %10s %8s\n", "Messung", "Median [ns]", "p99 [ns]", "Alloc/Op", "Anzahl");
+
+    std::vector<fs::path> shipped;
+    for (const auto& entry : fs::directory_iterator(mapDirectory))
+    {
+        if (entry.is_regular_file() && entry.path().extension() == ".txt") shipped.push_back(entry.path());
+    }
+    std::sort(shipped.begin(), shipped.end());
+
+    for (const auto& path : shipped)
+    {
+        benchMap(path.stem().string(), path.string(), results);
+    }
+
+    for (size_t size = 100; size <= maxSize; size *= 10)
+    {
+        std::string path = (fs::temp_directory_path() / ("benchSuite_" + std::to_string(size) + ".txt")).string();
+        writeSyntheticMap(path, size);
+        benchMap("synthetic" + std::to_string(size), path, results);
+        fs::remove(path);
+    }
+
+    if (!jsonPath.empty() && !writeJson(jsonPath, results))
+    {
+        std::fprintf(stderr, "%s konnte nicht geschrieben werden\n", jsonPath.c_str());
+        return 1;
+    }
+
+    if (comparePath.empty()) return 0;
+
+    std::map<std::string, double> baseline = readJson(comparePath);
+    size_t regressions = 0;
+
+    std::printf("\nVergleich mit %s (Regression ab +%.0f%%)\n", comparePath.c_str(), threshold);
+    for (const Result& result : results)
+    {
+        auto found = baseline.find(result.name);
+        if (found == baseline.end() || found->second <= 0) continue;
+
+        double change = (result.medianNs / found->second - 1) * 100;
+        bool regression = change > threshold;
+        regressions += regression;
+
+        std::printf("%-32s %+8.1f%%%s\n", result.name.c_str(), change, regression ? "  REGRESSION" : "");
+    }
+
+    std::printf("%zu Regressionen\n", regressions);
+    return regressions == 0 ? 0 : 1;
+}
@@ -0,0 +1,127 @@
+#include "headers/grid.h"
+#include "headers/mapLoader.h"
+#include "headers/mappedFile.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * Vergleicht den alten Kartenlader (std::getline, Zeichen für Zeichen mit at())
+ * mit dem neuen (mmap, memchr, memcpy) auf Dateien von 1 MB bis 1 GB.
+ *
+ * Aufruf: loaderBench [maxMB] [Ordner]
+ *   maxMB  größte Testdatei in MB (Standard 1024)
+ *   Ordner Ort für die Testdateien (Standard /tmp)
+ */
+
+namespace {
+
+const size_t WIDTH = 4000;
+
+///@brief Schreibt eine Testkarte mit etwa megabytes MB
+std::string writeMap(const std::string& directory, size_t megabytes)
+{
+    std::string path = directory + "/loaderBench_" + std::to_string(megabytes) + "MB.txt";
+    size_t height = megabytes * 1024 * 1024 / (WIDTH + 1);
+
+    std::ofstream out(path, std::ios::binary);
+    out << height << " " << WIDTH << "\n";
+
+    std::string platform(WIDTH, '-'), ladder(WIDTH, ' '), empty(WIDTH, ' ');
+    for (size_t col = 3; col < WIDTH; col += 40) ladder[col] = 'H';
+
+    for (size_t row = 0; row < height; ++row)
+    {
+        const std::string& line = (row % 5 == 4) ? platform : (row % 5 == 0 ? empty : ladder);
+        out.write(line.data(), static_cast<std::streamsize>(line.size() - row % 7)); //unterschiedlich lange Zeilen
+        out.put('\n');
+    }
+
+    return path;
+}
+
+///@brief der Lader vor der Umstellung: getline und ein at() pro Zeichen
+size_t loadOld(const std::string& path)
+{
+    std::ifstream map(path);
+    std::string line, sizes;
+
+    std::getline(map, sizes);
+    size_t separator = sizes.find(' ');
+    auto height = static_cast<size_t>(std::stoi(sizes.substr(0, separator)));
+    auto width = static_cast<size_t>(std::stoi(sizes.substr(separator + 1)));
+
+    std::vector<std::vector<char>> renderMap2D;
+    renderMap2D.resize(height, std::vector<char>(width, ' '));
+
+    size_t row = 0;
+    while (std::getline(map, line) && row < height)
+    {
+        for (size_t col = 0; col < width; ++col)
+        {
+            char input = (col < line.length()) ? line[col] : ' ';
+            renderMap2D.at(row).at(col) = input;
+        }
+        ++row;
+    }
+    return row;
+}
+
+///@brief der neue Lader: mmap, memchr, memcpy
+size_t loadNew(const std::string& path)
+{
+    MappedFile map(path);
+
+    size_t bodyOffset = 0, height = 0, width = 0;
+    std::string_view sizes = MapLoader::headerLine(map.data(), map.size(), bodyOffset);
+    size_t separator = sizes.find(' ');
+
+    MapLoader::parseDimension(sizes.substr(0, separator), height);
+    MapLoader::parseDimension(sizes.substr(separator + 1), width);
+
+    Grid grid(height, width, ' ');
+    return MapLoader::copyRows(map.data() + bodyOffset, map.size() - bodyOffset, grid);
+}
+
+template <typename Loader>
+double measure(Loader loader, const std::string& path, size_t& rows)
+{
+    auto start = std::chrono::steady_clock::now();
+    rows = loader(path);
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    size_t maxMegabytes = (argc > 1) ? std::stoul(argv[1]) : 1024;
+    std::string directory = (argc > 2) ? argv[2] : "/tmp";
+
+    std::cout << "Größe     alt [s]   neu [s]   alt [MB/s]  neu [MB/s]  Faktor\n";
+
+    for (size_t megabytes = 1; megabytes <= maxMegabytes; megabytes *= 4)
+    {
+        std::string path = writeMap(directory, megabytes);
+        size_t oldRows = 0, newRows = 0;
+
+        measure(loadNew, path, newRows); //Seitencache füllen
+        double oldTime = measure(loadOld, path, oldRows);
+        double newTime = measure(loadNew, path, newRows);
+
+        if (oldRows != newRows)
+        {
+            std::cerr << "Zeilenanzahl unterschiedlich: " << oldRows << " / " << newRows << "\n";
+        }
+
+        std::printf("%5zu MB  %8.3f  %8.3f  %10.1f  %10.1f  %6.1fx\n", megabytes, oldTime, newTime,
+                    static_cast<double>(megabytes) / oldTime, static_cast<double>(megabytes) / newTime, oldTime / newTime);
+
+        std::remove(path.c_str());
+    }
+
+    return 0;
+}
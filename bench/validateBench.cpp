@@ -0,0 +1,91 @@
+#include "headers/grid.h"
+#include "headers/mapValidator.h"
+#include "headers/threadPool.h"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * Skalierung der Kartenprüfung mit 1 bis N Threads (Spaltenbänder).
+ *
+ * Aufruf: validateBench [Breite] [Höhe] [maxThreads]
+ *   Standard: 20000 x 5000 Zellen, bis zu allen Hardware-Threads
+ */
+
+namespace {
+
+///@brief Baut eine gültige Karte: Plattformen alle 5 Zeilen, Leitern alle 40 Spalten
+Grid buildMap(size_t width, size_t height)
+{
+    Grid grid(height, width, ' ');
+
+    for (size_t row = 4; row < height; row += 5)
+    {
+        for (size_t col = 0; col < width; ++col)
+        {
+            grid(row, col) = (col % 97 == 50) ? ' ' : '-';
+        }
+        for (size_t col = 3; row + 5 < height && col < width; col += 40)
+        {
+            if (col % 97 == 50) continue; //keine Leiter an einer Lücke
+            grid(row + 1, col) = 'H';
+            grid(row + 2, col) = 'H';
+            grid(row + 3, col) = 'H';
+            grid(row + 4, col) = 'H';
+        }
+    }
+
+    grid(2, 1) = 'S';
+    grid(2, width - 2) = 'O';
+    return grid;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    size_t width = (argc > 1) ? std::stoul(argv[1]) : 20000;
+    size_t height = (argc > 2) ? std::stoul(argv[2]) : 5000;
+    size_t maxThreads = (argc > 3) ? std::stoul(argv[3]) : ThreadPool::hardwareThreads();
+
+    const Grid original = buildMap(width, height);
+    double single = 0;
+
+    std::printf("Karte %zu x %zu\nThreads  Zeit [ms]  Speedup  Ergebnis\n", width, height);
+
+    std::vector<size_t> threadCounts;
+    for (size_t threads = 1; threads < maxThreads; threads *= 2)
+    {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(maxThreads);
+
+    for (size_t threads : threadCounts)
+    {
+        std::unique_ptr<ThreadPool> pool;
+        if (threads > 1) pool = std::make_unique<ThreadPool>(threads - 1);
+
+        double best = 0;
+        bool ok = false;
+
+        for (int run = 0; run < 3; ++run)
+        {
+            Grid grid = original;
+
+            auto start = std::chrono::steady_clock::now();
+            ValidationResult result = MapValidator::validate(grid, 3, 1, pool.get());
+            double time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            ok = result.ok();
+            if (run == 0 || time < best) best = time;
+        }
+
+        if (threads == 1) single = best;
+
+        std::printf("%7zu  %9.1f  %7.2f  %s\n", threads, best, single / best, ok ? "gültig" : "ungültig");
+    }
+
+    return 0;
+}
@@ -0,0 +1,234 @@
+#include "headers/captureRenderer.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+/**
+ * @brief Hängt bytes als JSON-Zeichenkette an, mit "\r\n" als Zeilenende.
+ *
+ * Steuerzeichen (auch ESC) werden als \\uXXXX geschrieben, alles ab 0x80 bleibt
+ * unverändert, die Ausgabe ist also gültiges UTF-8, wenn bytes es ist.
+ */
+void appendJsonString(std::string& out, const std::string& bytes)
+{
+    out.push_back('"');
+    for (char byte : bytes)
+    {
+        auto code = static_cast<unsigned char>(byte);
+        switch (byte)
+        {
+            case '"':
+                out.append("\\\"");
+                break;
+            case '\\':
+                out.append("\\\\");
+                break;
+            case '\n':
+                out.append("\\r\\n");
+                break;
+            default:
+                if (code < 0x20 || code == 0x7F)
+                {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", code);
+                    out.append(escaped);
+                } else {
+                    out.push_back(byte);
+                }
+        }
+    }
+    out.push_back('"');
+}
+
+///@brief Hängt einen Unicode-Codepunkt als UTF-8 an
+void appendUtf8(std::string& out, unsigned long code)
+{
+    if (code < 0x80)
+    {
+        out.push_back(static_cast<char>(code));
+    } else if (code < 0x800)
+    {
+        out.push_back(static_cast<char>(0xC0 | (code >> 6)));
+        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xE0 | (code >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    }
+}
+
+/**
+ * @brief Liest eine JSON-Zeichenkette ab text[pos] (dort steht '"').
+ * @param pos danach hinter dem schließenden '"'
+ * @return False, wenn die Zeichenkette nicht abgeschlossen oder fehlerhaft ist
+ */
+bool readJsonString(const std::string& text, size_t& pos, std::string& out)
+{
+    if (pos >= text.size() || text[pos] != '"') return false;
+
+    for (++pos; pos < text.size(); ++pos)
+    {
+        char c = text[pos];
+        if (c == '"')
+        {
+            ++pos;
+            return true;
+        }
+        if (c != '\\')
+        {
+            out.push_back(c);
+            continue;
+        }
+
+        if (++pos >= text.size()) return false;
+        switch (text[pos])
+        {
+            case 'n': out.push_back('\n'); break;
+            case 'r': out.push_back('\r'); break;
+            case 't': out.push_back('\t'); break;
+            case 'b': out.push_back('\b'); break;
+            case 'f': out.push_back('\f'); break;
+            case 'u':
+            {
+                if (pos + 4 >= text.size()) return false;
+                char* end = nullptr;
+                std::string digits = text.substr(pos + 1, 4);
+                unsigned long code = std::strtoul(digits.c_str(), &end, 16);
+                if (end != digits.c_str() + 4) return false;
+                appendUtf8(out, code);
+                pos += 4;
+                break;
+            }
+            default: out.push_back(text[pos]); //\" \\ \/
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Zerlegt eine Ereigniszeile wie [0.412345, "o", "..."].
+ * @return False, wenn die Zeile kein Ereignis ist
+ */
+bool parseEvent(const std::string& line, double& time, std::string& type, std::string& data)
+{
+    size_t pos = line.find('[');
+    if (pos == std::string::npos) return false;
+
+    const char* begin = line.c_str() + pos + 1;
+    char* end = nullptr;
+    time = std::strtod(begin, &end);
+    if (end == begin) return false;
+
+    pos = line.find('"', static_cast<size_t>(end - line.c_str()));
+    if (pos == std::string::npos || !readJsonString(line, pos, type)) return false;
+
+    pos = line.find('"', pos);
+    return pos != std::string::npos && readJsonString(line, pos, data);
+}
+
+///@brief Schreibt alles mit write(2), auch wenn nur ein Teil auf einmal geht
+void writeAll(int fd, const std::string& bytes)
+{
+    const char* data = bytes.data();
+    size_t left = bytes.size();
+
+    while (left > 0)
+    {
+        ssize_t written = write(fd, data, left);
+        if (written < 0)
+        {
+            if (errno == EINTR) continue;
+            return;
+        }
+        data += written;
+        left -= static_cast<size_t>(written);
+    }
+}
+
+}
+
+/**
+ * @brief Legt die Datei an und schreibt den Kopf.
+ * @param path z.B. "logs/spiel.cast", eine vorhandene Datei wird überschrieben
+ * @param rows Zeilen des aufgenommenen Terminals
+ * @param cols Spalten des aufgenommenen Terminals
+ */
+CaptureRenderer::CaptureRenderer(const std::string& path, unsigned short rows, unsigned short cols)
+        : Renderer(rows, cols), file(path, std::ios::binary | std::ios::trunc), start(std::chrono::steady_clock::now())
+{
+    file << "{\"version\": 2, \"width\": " << cols << ", \"height\": " << rows
+         << ", \"timestamp\": " << static_cast<long long>(std::time(nullptr)) << "}\n";
+}
+
+///@brief True, wenn die Datei angelegt werden konnte und bisher alles geschrieben wurde
+bool CaptureRenderer::isOpen() const
+{
+    return file.good();
+}
+
+/**
+ * @brief Schreibt ein Bild als Ereignis mit der Zeit seit dem Start.
+ *
+ * Jedes Ereignis ist eine Zeile und wird sofort geschrieben, bricht das Spiel ab,
+ * ist die Aufnahme bis zum letzten Bild lesbar.
+ *
+ * @param bytes das ganze Bild mit ANSI-Sequenzen
+ */
+void CaptureRenderer::output(const std::string& bytes)
+{
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    char time[32];
+    std::snprintf(time, sizeof(time), "%.6f", elapsed.count());
+
+    std::string event = "[";
+    event.append(time);
+    event.append(", \"o\", ");
+    appendJsonString(event, bytes);
+    event.append("]\n");
+
+    file << event;
+    file.flush();
+}
+
+/**
+ * @brief Spielt eine Aufnahme in der aufgenommenen Geschwindigkeit ab.
+ *
+ * Es werden nur die Ausgabeereignisse ("o") geschrieben, andere (z.B. Eingaben aus
+ * asciinema) werden übersprungen. Die Größe im Kopf wird nicht geprüft, ein kleineres
+ * Terminal zeigt die Bilder verschoben.
+ *
+ * @param path Datei im asciicast-Format, z.B. von CaptureRenderer
+ * @param fileDescriptor Ausgabe, z.B. STDOUT_FILENO
+ * @return False, wenn die Datei nicht lesbar ist oder eine Zeile kein Ereignis ist
+ */
+bool CaptureRenderer::play(const std::string& path, int fileDescriptor)
+{
+    std::ifstream cast(path, std::ios::binary);
+    std::string line;
+
+    if (!std::getline(cast, line) || line.empty() || line[0] != '{') return false;
+
+    auto playStart = std::chrono::steady_clock::now();
+
+    while (std::getline(cast, line))
+    {
+        if (line.empty()) continue;
+
+        double time;
+        std::string type, data;
+        if (!parseEvent(line, time, type, data)) return false;
+        if (type != "o") continue;
+
+        std::this_thread::sleep_until(playStart + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(time)));
+        writeAll(fileDescriptor, data);
+    }
+
+    return true;
+}
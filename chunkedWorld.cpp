@@ -0,0 +1,502 @@
+#include "headers/chunkedWorld.h"
+#include "headers/mappedFile.h"
+#include "headers/profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <unistd.h>
+
+namespace {
+
+const char MAGIC[4] = {'A', 'C', 'H', 'K'};
+const uint32_t VERSION = 2;
+
+/**
+ * Kopf einer .achunk-Datei. Danach folgen chunkRows x chunkCols Blockanfänge (je uint64_t,
+ * 0 für einen leeren Block) und die Blöcke mit je chunkSize x chunkSize Zellen, Zeile für
+ * Zeile. Blöcke am rechten und unteren Rand sind mit Leerzeichen aufgefüllt.
+ */
+struct Header {
+    char magic[4];
+    uint32_t version;
+    uint64_t rules; ///< RuleProfile, mit dem geprüft wurde
+    uint64_t chunkSize;
+    uint64_t height, width;
+    uint64_t startRow, startCol, goalRow, goalCol;
+};
+
+uint64_t nanosecondsSince(std::chrono::steady_clock::time_point begin)
+{
+    return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count());
+}
+
+}
+
+/**
+ * @param memoryBudget höchstens so viele Bytes an Blöcken bleiben geladen
+ */
+ChunkedWorld::ChunkedWorld(size_t memoryBudget) : budget(memoryBudget), prefetcher(std::make_unique<ThreadPool>(1))
+{
+}
+
+ChunkedWorld::~ChunkedWorld()
+{
+    //laufende Vorausladungen greifen noch auf fd und den Cache zu
+    prefetcher.reset();
+    if (fd >= 0) close(fd);
+}
+
+/**
+ * @brief Öffnet eine .achunk-Datei. Es werden nur Kopf und Blockverzeichnis gelesen.
+ * @param path Pfad der mit convert() erzeugten Datei
+ * @return False, wenn die Datei fehlt oder kein gültiges .achunk ist
+ */
+bool ChunkedWorld::open(const std::string& path)
+{
+    int file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file < 0) return false;
+
+    Header header{};
+    if (pread(file, &header, sizeof(Header), 0) != static_cast<ssize_t>(sizeof(Header))
+        || std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION || header.chunkSize == 0
+        || header.rules > static_cast<uint64_t>(RuleProfile::TALL))
+    {
+        close(file);
+        return false;
+    }
+
+    size_t blockRows = (header.height + header.chunkSize - 1) / header.chunkSize;
+    size_t blockCols = (header.width + header.chunkSize - 1) / header.chunkSize;
+    std::vector<uint64_t> index(blockRows * blockCols);
+    auto indexBytes = static_cast<ssize_t>(index.size() * sizeof(uint64_t));
+
+    if (pread(file, index.data(), static_cast<size_t>(indexBytes), sizeof(Header)) != indexBytes)
+    {
+        close(file);
+        return false;
+    }
+
+    if (fd >= 0) close(fd);
+    fd = file;
+    rows = header.height;
+    cols = header.width;
+    chunkSize = header.chunkSize;
+    chunkRows = blockRows;
+    chunkCols = blockCols;
+    startPos = {header.startRow, header.startCol};
+    goalPos = {header.goalRow, header.goalCol};
+    rules = static_cast<RuleProfile>(header.rules);
+    offsets = std::move(index);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    chunks.clear();
+    lru.clear();
+    stats = Stats();
+    lastChunk = NONE;
+    lastCells.reset();
+
+    return true;
+}
+
+/**
+ * @brief Übersetzt eine .txt-Karte in eine .achunk-Datei, ohne sie ganz in den Speicher zu laden.
+ *
+ * Die Karte wird in Streifen von chunkSize Zeilen (plus zwei Zeilen für die Prüfung der
+ * Plattformen) aus der eingeblendeten Datei kopiert, mit einem MapValidator über alle
+ * Streifen hinweg geprüft und in Blöcke zerlegt. Es werden nur etwa chunkSize + 2 Zeilen
+ * gleichzeitig gehalten. Wie bei MapCache::store() wird erst in eine temporäre Datei
+ * geschrieben. Ob das Ziel erreichbar ist, wird nicht geprüft, dafür wäre die ganze
+ * Karte nötig.
+ *
+ * @param textPath Pfad der .txt-Datei
+ * @param chunkPath Pfad der neuen .achunk-Datei
+ * @param chunkSize Kantenlänge eines Blocks in Zellen
+ * @param rules Regelprofil für die Prüfung, steht danach in der Datei
+ * @return wie Level::loadText(); OPEN_FAILED auch, wenn nicht geschrieben werden konnte
+ */
+LoadReport ChunkedWorld::convert(const std::string& textPath, const std::string& chunkPath, size_t chunkSize,
+                                 RuleProfile rules)
+{
+    PROFILE_SCOPE("chunk.convert");
+
+    LoadReport report;
+    MappedFile file(textPath);
+
+    if (!file.isOpen() || chunkSize == 0)
+    {
+        report.status = LoadReport::Status::OPEN_FAILED;
+        return report;
+    }
+
+    size_t bodyOffset = 0, height = 0, width = 0;
+    std::string_view sizes = MapLoader::headerLine(file.data(), file.size(), bodyOffset);
+    size_t separator = sizes.find(' ');
+
+    report.heightError = MapLoader::parseDimension(sizes.substr(0, separator), height);
+    report.widthError = MapLoader::parseDimension(sizes.substr(separator + 1), width);
+
+    if (report.heightError != MapLoader::DimensionError::NONE || report.widthError != MapLoader::DimensionError::NONE)
+    {
+        report.status = LoadReport::Status::BAD_DIMENSION;
+        return report;
+    }
+
+    size_t blockRows = (height + chunkSize - 1) / chunkSize;
+    size_t blockCols = (width + chunkSize - 1) / chunkSize;
+    std::vector<uint64_t> index(blockRows * blockCols, 0);
+    uint64_t offset = sizeof(Header) + index.size() * sizeof(uint64_t);
+
+    std::string temporary = chunkPath + ".tmp";
+    std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        report.status = LoadReport::Status::OPEN_FAILED;
+        return report;
+    }
+    out.seekp(static_cast<std::streamoff>(offset));
+
+    const char* body = file.data() + bodyOffset;
+    size_t remaining = file.size() - bodyOffset;
+
+    RuleLimits limits = limitsOf(rules);
+    MapValidator validator(0, width, limits.maxSpace, limits.playerHeight);
+    Grid band;
+    std::vector<char> above, block(chunkSize * chunkSize);
+
+    for (size_t blockRow = 0; blockRow < blockRows; ++blockRow)
+    {
+        size_t first = blockRow * chunkSize;
+        size_t count = std::min(chunkSize, height - first);
+
+        //zwei Zeilen mehr, weil eine Plattform die übernächste Zeile prüft
+        band.assign(std::min(count + 2, height - first), width, ' ');
+        MapLoader::copyRows(body, remaining, band);
+
+        for (size_t row = 0; row < count; ++row)
+        {
+            const char* previous = (row > 0) ? band.row(row - 1) : (first > 0 ? above.data() : nullptr);
+            const char* below2 = (row + 2 < band.getHeight()) ? band.row(row + 2) : nullptr;
+            validator.consumeRow(first + row, previous, band.row(row), below2);
+        }
+        above.assign(band.row(count - 1), band.row(count - 1) + band.getStride());
+
+        for (size_t blockCol = 0; blockCol < blockCols; ++blockCol)
+        {
+            size_t left = blockCol * chunkSize;
+            size_t span = std::min(chunkSize, width - left);
+            bool empty = true;
+
+            std::fill(block.begin(), block.end(), ' ');
+            for (size_t row = 0; row < count; ++row)
+            {
+                const char* source = band.row(row) + left;
+                std::memcpy(&block[row * chunkSize], source, span);
+                empty = empty && std::all_of(source, source + span, [](char c) { return c == ' '; });
+            }
+
+            if (empty) continue;
+
+            index[blockRow * blockCols + blockCol] = offset;
+            out.write(block.data(), static_cast<std::streamsize>(block.size()));
+            offset += block.size();
+        }
+
+        size_t consumed = MapLoader::skipRows(body, remaining, count);
+        body += consumed;
+        remaining -= consumed;
+    }
+
+    report.validation = validator.finish();
+    if (report.validation.ok() && (report.validation.startRow == ValidationResult::NO_POS
+                                   || report.validation.goalRow == ValidationResult::NO_POS))
+    {
+        report.validation.recordError(ValidationResult::Error::MISSING_SYMBOL, 0, 0);
+    }
+
+    if (!report.validation.ok())
+    {
+        out.close();
+        std::remove(temporary.c_str());
+        report.status = LoadReport::Status::INVALID;
+        return report;
+    }
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.rules = static_cast<uint64_t>(rules);
+    header.chunkSize = chunkSize;
+    header.height = height;
+    header.width = width;
+    header.startRow = report.validation.startRow + 1;
+    header.startCol = report.validation.startCol;
+    header.goalRow = report.validation.goalRow + 1;
+    header.goalCol = report.validation.goalCol;
+
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    out.write(reinterpret_cast<const char*>(index.data()), static_cast<std::streamsize>(index.size() * sizeof(uint64_t)));
+    out.close();
+
+    if (!out || std::rename(temporary.c_str(), chunkPath.c_str()) != 0)
+    {
+        std::remove(temporary.c_str());
+        report.status = LoadReport::Status::OPEN_FAILED;
+    }
+
+    return report;
+}
+
+size_t ChunkedWorld::width() const
+{
+    return cols;
+}
+
+size_t ChunkedWorld::height() const
+{
+    return rows;
+}
+
+size_t ChunkedWorld::getChunkSize() const
+{
+    return chunkSize;
+}
+
+///@return Regelprofil, mit dem die Karte geprüft wurde und gespielt wird
+RuleProfile ChunkedWorld::getRules() const
+{
+    return rules;
+}
+
+///@return {Zeile, Spalte} des Spielers am Start
+const std::array<size_t, 2>& ChunkedWorld::getStartPos() const
+{
+    return startPos;
+}
+
+///@return {Zeile, Spalte}, auf der der Spieler gewonnen hat
+const std::array<size_t, 2>& ChunkedWorld::getGoalPos() const
+{
+    return goalPos;
+}
+
+/**
+ * @brief Zeichen einer Zelle, lädt dafür wenn nötig ihren Block.
+ * @return ' ' außerhalb der Karte und in leeren Blöcken
+ */
+char ChunkedWorld::cell(size_t row, size_t col) const
+{
+    if (row >= rows || col >= cols) return ' ';
+
+    const char* cells = acquire(chunkOf(row, col));
+    return cells == nullptr ? ' ' : cells[(row % chunkSize) * chunkSize + col % chunkSize];
+}
+
+bool ChunkedWorld::isLadder(size_t col, size_t row) const
+{
+    return cell(row, col) == 'H';
+}
+
+/**
+ * @brief Erste Plattform in Spalte col in Zeile row oder darunter.
+ *
+ * Geht die Spalte blockweise durch, leere Blöcke werden übersprungen, ohne sie zu lesen.
+ *
+ * @return Zeile der Plattform, NONE wenn keine
+ */
+size_t ChunkedWorld::platformAtOrBelow(size_t col, size_t row) const
+{
+    if (col >= cols) return NONE;
+
+    while (row < rows)
+    {
+        size_t end = std::min((row / chunkSize + 1) * chunkSize, rows);
+        const char* cells = acquire(chunkOf(row, col));
+
+        if (cells != nullptr)
+        {
+            const char* column = cells + col % chunkSize;
+            for (; row < end; ++row)
+            {
+                if (column[(row % chunkSize) * chunkSize] == '-') return row;
+            }
+        }
+        row = end;
+    }
+
+    return NONE;
+}
+
+/**
+ * @brief Letzte Plattform in Spalte col in Zeile row oder darüber.
+ *
+ * row außerhalb der Karte zählt wie die unterste Zeile, wie bei TilePlanes.
+ *
+ * @return Zeile der Plattform, NONE wenn keine
+ */
+size_t ChunkedWorld::platformAtOrAbove(size_t col, size_t row) const
+{
+    if (col >= cols || rows == 0) return NONE;
+    if (row >= rows) row = rows - 1;
+
+    while (true)
+    {
+        size_t begin = row / chunkSize * chunkSize;
+        const char* cells = acquire(chunkOf(row, col));
+
+        if (cells != nullptr)
+        {
+            const char* column = cells + col % chunkSize;
+            for (size_t current = row + 1; current-- > begin;)
+            {
+                if (column[(current % chunkSize) * chunkSize] == '-') return current;
+            }
+        }
+
+        if (begin == 0) return NONE;
+        row = begin - 1;
+    }
+}
+
+/**
+ * @brief Lädt den Block einer Zelle im Hintergrund, falls er nicht schon geladen ist.
+ *
+ * Wird z.B. mit einer Zelle einen halben Block vor dem Spieler in Laufrichtung aufgerufen.
+ */
+void ChunkedWorld::prefetch(size_t col, size_t row) const
+{
+    if (row >= rows || col >= cols) return;
+
+    size_t chunk = chunkOf(row, col);
+    if (offsets[chunk] == 0) return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (chunks.count(chunk) != 0) return;
+
+        chunks[chunk];
+        ++stats.prefetched;
+    }
+
+    prefetcher->submit([this, chunk] { store(chunk, read(chunk)); });
+}
+
+ChunkedWorld::Stats ChunkedWorld::getStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+size_t ChunkedWorld::chunkOf(size_t row, size_t col) const
+{
+    return (row / chunkSize) * chunkCols + col / chunkSize;
+}
+
+/**
+ * @brief Zellen eines Blocks, bei Bedarf von der Platte gelesen.
+ *
+ * Wird der Block gerade im Hintergrund geladen, wird darauf gewartet. Der Block bleibt
+ * gültig, bis ein anderer Block angefordert wird, auch wenn er dazwischen aus dem
+ * Cache verdrängt wird.
+ *
+ * @return nullptr für einen leeren Block
+ */
+const char* ChunkedWorld::acquire(size_t chunk) const
+{
+    if (chunk == lastChunk) return lastCells->empty() ? nullptr : lastCells->data();
+    if (offsets[chunk] == 0) return nullptr;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    auto found = chunks.find(chunk);
+
+    if (found != chunks.end() && found->second.cells)
+    {
+        ++stats.hits;
+        lru.splice(lru.begin(), lru, found->second.age);
+        lastCells = found->second.cells;
+    } else {
+        auto begin = std::chrono::steady_clock::now();
+
+        //wird der Block schon vorausgeladen, darauf warten; er kann danach schon wieder verdrängt sein
+        while (found != chunks.end() && !found->second.cells)
+        {
+            loaded.wait(lock);
+            found = chunks.find(chunk);
+        }
+
+        if (found != chunks.end())
+        {
+            lru.splice(lru.begin(), lru, found->second.age);
+            lastCells = found->second.cells;
+        } else {
+            chunks[chunk];
+            lock.unlock();
+            Cells cells = read(chunk);
+            store(chunk, cells);
+            lock.lock();
+            lastCells = std::move(cells);
+        }
+
+        uint64_t waited = nanosecondsSince(begin);
+        ++stats.misses;
+        stats.missNsTotal += waited;
+        stats.missNsMax = std::max(stats.missNsMax, waited);
+    }
+
+    lastChunk = chunk;
+    return lastCells->empty() ? nullptr : lastCells->data();
+}
+
+/**
+ * @brief Liest einen Block aus der Datei.
+ * @return die Zellen; leer, wenn nicht gelesen werden konnte (der Block zählt dann als leer)
+ */
+ChunkedWorld::Cells ChunkedWorld::read(size_t chunk) const
+{
+    PROFILE_SCOPE("chunk.read");
+
+    auto cells = std::make_shared<std::vector<char>>(chunkSize * chunkSize);
+    auto bytes = static_cast<ssize_t>(cells->size());
+
+    if (pread(fd, cells->data(), cells->size(), static_cast<off_t>(offsets[chunk])) != bytes)
+    {
+        cells->clear();
+    }
+
+    return cells;
+}
+
+/**
+ * @brief Legt einen gelesenen Block in den Cache und verdrängt die am längsten nicht
+ * benutzten, bis das Budget wieder eingehalten ist.
+ */
+void ChunkedWorld::store(size_t chunk, Cells cells) const
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        Entry& entry = chunks[chunk];
+        entry.cells = std::move(cells);
+        lru.push_front(chunk);
+        entry.age = lru.begin();
+
+        stats.residentBytes += entry.cells->size();
+        stats.peakBytes = std::max(stats.peakBytes, stats.residentBytes);
+
+        while (stats.residentBytes > budget && lru.size() > 1)
+        {
+            size_t victim = lru.back();
+            lru.pop_back();
+
+            auto evicted = chunks.find(victim);
+            stats.residentBytes -= evicted->second.cells->size();
+            chunks.erase(evicted);
+            ++stats.evicted;
+        }
+    }
+    loaded.notify_all();
+}
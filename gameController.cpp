@@ -1,11 +1,85 @@
 #include "headers/gameController.h"
+#include "headers/captureRenderer.h"
+#include "headers/profiler.h"
+#include <algorithm>
+#include <cctype>
+#include <ctime>
+#include <filesystem>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+namespace {
+
+const char* const CONTROLS = "D - rechts, A - links, F zu klettern. E zum Beenden";
+
+const size_t MAX_PENDING = 4; ///< so viele Tasten werden höchstens vorgemerkt, der Rest verworfen
+
+const unsigned short CAPTURE_ROWS = 24, CAPTURE_COLS = 80; ///< Größe einer Aufnahme ohne Terminal
+
+/**
+ * @brief Legt die Ausgabe für die Bilder nach den Einstellungen an.
+ *
+ * Eine Aufnahme hat die Größe des Terminals, in dem das Spiel läuft, ohne Terminal
+ * CAPTURE_ROWS x CAPTURE_COLS. Lässt sich die Datei nicht anlegen, wird ins Terminal
+ * gezeichnet.
+ */
+std::unique_ptr<RenderBackend> makeRenderer(const GameOptions& options)
+{
+    std::unique_ptr<Renderer> renderer;
+
+    switch (options.render)
+    {
+        case RenderSink::NONE:
+            return std::make_unique<NullRenderer>();
+        case RenderSink::CAPTURE:
+        {
+            winsize size{};
+            if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) != 0 || size.ws_row == 0 || size.ws_col == 0)
+            {
+                size.ws_row = CAPTURE_ROWS;
+                size.ws_col = CAPTURE_COLS;
+            }
+
+            auto capture = std::make_unique<CaptureRenderer>(options.capturePath, size.ws_row, size.ws_col);
+            if (capture->isOpen())
+            {
+                renderer = std::move(capture);
+                break;
+            }
+            std::cerr << options.capturePath << " konnte nicht angelegt werden, es wird ins Terminal gezeichnet\n";
+            renderer = std::make_unique<Renderer>(STDOUT_FILENO);
+            break;
+        }
+        case RenderSink::TERMINAL:
+            renderer = std::make_unique<Renderer>(STDOUT_FILENO);
+            break;
+    }
+
+    renderer->setMode(options.fullMap ? Renderer::Mode::FULL : Renderer::Mode::CAMERA);
+    renderer->setDeadZone(options.deadZone);
+    return renderer;
+}
+
+}
 
 /**
  * @brief Konstruktor, initialisiert das Spiel mit dem Startzustand.
+ * @param options Einstellungen aus der Kommandozeile
  */
-GameController::GameController():
-                map(), player(map)
+GameController::GameController(const GameOptions& options):
+                lineMode(options.lineMode || isatty(STDIN_FILENO) != 1), debug(options.debug), hud(options.hud),
+                tick(std::max<size_t>(options.tickMs, 1)), recordDirectory(options.recordDirectory), recording(false),
+                renderer(makeRenderer(options)), map(options.validationThreads, options.rules), player(map)
 {
+    renderer->setPlayerHeight(limitsOf(options.rules).playerHeight);
+
+    if (!lineMode)
+    {
+        renderer->setFooter(CONTROLS); //im Echtzeitmodus steht die Steuerung fest unter der Karte
+    } else {
+        renderer->setPrompt(CONTROLS);
+    }
+
     endGame = false;
     gameOver = true;
     win = false;
@@ -22,8 +96,13 @@ void GameController::processInput()
         gameReset();
     } else
     {
+        size_t framesBefore = renderer->getFrameCount();
+        size_t bytesBefore = renderer->getTotalBytes();
+
         player.reset();
+        drawPlayer();
 
+        startRecording();
         playerMoveLoop();
 
         if(win)
@@ -33,6 +112,14 @@ void GameController::processInput()
             std::cout << "\nGAME OVER\n\n";
         }
 
+        size_t frames = renderer->getFrameCount() - framesBefore;
+        size_t bytes = renderer->getTotalBytes() - bytesBefore;
+        std::cout << "Ausgabe: " << frames << " Bilder, " << bytes / (frames ? frames : 1)
+                  << " Bytes pro Bild (letztes Bild " << renderer->getLastFrameBytes() << " Bytes)\n";
+
+        if (debug) reportLatency();
+        finishRecording();
+
         gameOver = true;
     }
 }
@@ -53,14 +140,19 @@ void GameController::gameReset()
 
 /**
  * @brief Zeigt das Startmenü und ermöglicht die Auswahl einer Karte.
+ *
+ * Vorher werden Änderungen im Kartenordner übernommen (Map::refresh()). Neben jeder
+ * Karte steht, ob sie gültig ist, warum sie ungültig ist oder ob sie im Hintergrund
+ * noch geprüft wird.
  */
 void GameController::startMenu() {
-    auto mapList = map.getMapsNames();
+    map.refresh();
+    const auto& mapList = map.getMapsNames();
 
     std::cout << "\nWählen Sie die Karte. Um Spiel zu beenden, geben Sie -1 ein\n\n";
 
     for (size_t i = 0; i < mapList.size(); ++i) {
-        std::cout << "[" << i+1 << "] " << mapList[i] << "\n";
+        std::cout << "[" << i+1 << "] " << mapList[i] << " - " << map.getMapStatus(i) << "\n";
     }
 }
 
@@ -117,22 +209,242 @@ void GameController::selectMapLoop()
 
 /**
  * @brief Führt die Bewegungsschleife des Spielers aus, bis das Spiel gewonnen oder verloren ist.
+ *
+ * Im Terminal in Echtzeit, sonst (oder wenn der Rohmodus nicht geht) zeilenweise.
  */
 void GameController::playerMoveLoop()
+{
+    latencies.clear();
+
+    if (!lineMode)
+    {
+        TerminalInput terminal;
+        if (terminal.isRaw())
+        {
+            realtimeMoveLoop(terminal);
+            return;
+        }
+    }
+
+    lineMoveLoop();
+}
+
+/**
+ * @brief Spielt mit festem Takt: Tasten sammeln, dann pro Takt einen Zug ausführen.
+ *
+ * Zwischen zwei Takten wird mit poll() auf Tasten gewartet und alles gelesen, was
+ * anliegt. Am Takt wird die älteste vorgemerkte Taste ausgeführt. Gehaltene Tasten
+ * bewegen den Spieler so mit der Wiederholrate der Tastatur, höchstens aber einmal
+ * pro Takt. Gezeichnet wird nur, wenn sich die Position geändert hat. Ist ein Takt
+ * verpasst, wird nicht nachgeholt, sondern der nächste ab jetzt gezählt.
+ *
+ * Für die Latenz zählt die Zeit vom Lesen der Taste bis das Bild geschrieben ist.
+ *
+ * @param terminal Eingabe im Rohmodus
+ */
+void GameController::realtimeMoveLoop(const TerminalInput& terminal)
+{
+    struct PendingKey {
+        char key;
+        TerminalInput::Clock::time_point pressed;
+    };
+
+    std::vector<PendingKey> pending;
+    auto nextTick = TerminalInput::Clock::now() + tick;
+
+    while(!(win || lose))
+    {
+        while (terminal.waitUntil(nextTick))
+        {
+            char keys[64];
+            size_t count = terminal.read(keys, sizeof(keys));
+            auto now = TerminalInput::Clock::now();
+
+            for (size_t i = 0; i < count && pending.size() < MAX_PENDING; ++i)
+            {
+                char key = keys[i] == TerminalInput::INTERRUPT ? 'E' : static_cast<char>(std::toupper(keys[i]));
+                pending.push_back({key, now});
+            }
+        }
+
+        auto now = TerminalInput::Clock::now();
+        nextTick = std::max(nextTick + tick, now);
+
+        if (pending.empty()) continue;
+
+        PendingKey next = pending.front();
+        pending.erase(pending.begin());
+
+        size_t framesBefore = renderer->getFrameCount();
+
+        move(next.key);
+
+        if (renderer->getFrameCount() != framesBefore)
+        {
+            std::chrono::duration<double, std::milli> latency = TerminalInput::Clock::now() - next.pressed;
+            latencies.push_back(latency.count());
+        }
+
+        showHud();
+
+        win = player.hasWon();
+        lose = player.isDead();
+    }
+}
+
+/**
+ * @brief Liest Züge blockierend Zeile für Zeile, für Pipes und Skripte.
+ */
+void GameController::lineMoveLoop()
 {
     while(!(win || lose))
     {
         char input;
-        std::cout << "D - rechts, A - links, F zu klettern. E zum Beenden\n";
+        renderer->prompt();
         std::cin >> input;
 
-        player.updatePosition(input);
+        move(input);
+        showHud();
 
         win = player.hasWon();
         lose = player.isDead();
     }
 }
 
+/**
+ * @brief Führt einen Zug aus und zeichnet ihn auf, falls aufgezeichnet wird.
+ *
+ * Ein neues Bild gibt es nur, wenn sich die Position geändert hat.
+ *
+ * @param input Eingabe des Spielers
+ */
+void GameController::move(char input)
+{
+    //Leerraum bewirkt nichts und zählt auch beim Abspielen (Simulation::run) nicht als Zug
+    if (recording && !std::isspace(static_cast<unsigned char>(input)))
+    {
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(TerminalInput::Clock::now() - gameStart);
+        log.record(input, static_cast<uint32_t>(elapsed.count()));
+    }
+
+    switch (player.updatePosition(input))
+    {
+        case Physics::Outcome::MOVED:
+            drawPlayer();
+            break;
+        case Physics::Outcome::NO_LADDER:
+            renderer->message("Es gibt hier kein Leiter");
+            break;
+        case Physics::Outcome::BLOCKED:
+        case Physics::Outcome::DIED:
+        case Physics::Outcome::QUIT:
+            break;
+    }
+}
+
+/**
+ * @brief Meldet ein Bild mit der aktuellen Karte und Position an die Ausgabe.
+ *
+ * Die Karte wird nicht kopiert. Die Ausgabe zeichnet nur die geänderten Zellen neu,
+ * solange dieselbe Karte angezeigt wird.
+ */
+void GameController::drawPlayer()
+{
+    PROFILE_SCOPE("map.render");
+
+    const PlayerState& state = player.getState();
+    renderer->drawFrame(map.getMap(), state.x, state.y);
+}
+
+/**
+ * @brief Beginnt die Aufzeichnung eines Spiels: Karte und Startzustand.
+ *
+ * Es wird nur aufgezeichnet, wenn es den Ordner für Aufzeichnungen gibt.
+ */
+void GameController::startRecording()
+{
+    std::error_code error;
+    recording = !recordDirectory.empty() && std::filesystem::is_directory(recordDirectory, error);
+    if (!recording) return;
+
+    log = InputLog();
+    log.mapName = map.getMapName();
+    log.mapHash = InputLog::hashLevel(*map.getLevel());
+    log.rules = map.getLevel()->rules;
+    log.startX = player.getState().x;
+    log.startY = player.getState().y;
+
+    gameStart = TerminalInput::Clock::now();
+}
+
+/**
+ * @brief Schreibt die Aufzeichnung mit dem Endzustand in den Ordner für Aufzeichnungen.
+ *
+ * Dateiname: Karte, Datum und Uhrzeit, Prozessnummer, z.B. spiel-20240131-154500-4711.alog
+ */
+void GameController::finishRecording()
+{
+    if (!recording) return;
+    recording = false;
+
+    const PlayerState& state = player.getState();
+    log.end.won = win;
+    log.end.dead = state.dead;
+    log.end.x = state.x;
+    log.end.y = state.y;
+    log.end.steps = 0;
+    for (const InputRun& run : log.runs) log.end.steps += run.count;
+
+    char stamp[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", std::localtime(&now));
+
+    std::filesystem::path path = std::filesystem::path(recordDirectory)
+            / (std::filesystem::path(log.mapName).stem().string() + "-" + stamp + "-"
+               + std::to_string(getpid()) + InputLog::EXTENSION);
+
+    if (log.write(path.string()))
+    {
+        std::cout << "Aufzeichnung: " << path.string() << "\n";
+    } else {
+        std::cerr << path.string() << " konnte nicht geschrieben werden\n";
+    }
+}
+
+/**
+ * @brief Gibt die Latenz von der Taste bis zum Bild für das letzte Spiel aus.
+ *
+ * Nur im Echtzeitmodus gibt es Messwerte, im Zeilenmodus wartet das Spiel auf Enter.
+ */
+void GameController::reportLatency()
+{
+    if (latencies.empty())
+    {
+        std::cout << "Latenz: keine Messwerte\n";
+        return;
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+
+    std::cout << "Latenz Taste bis Bild: " << latencies.size() << " Züge, Median "
+              << latencies[latencies.size() / 2] << " ms, p99 "
+              << latencies[std::min(latencies.size() - 1, latencies.size() * 99 / 100)] << " ms, max "
+              << latencies.back() << " ms\n";
+}
+
+/**
+ * @brief Gibt die Messwerte des Profilers als eine Zeile unter dem Bild aus, falls eingeschaltet.
+ *
+ * Die Zeile wird beim nächsten Änderungsbild wieder gelöscht.
+ */
+void GameController::showHud() const
+{
+    if (hud)
+    {
+        renderer->message(Profiler::hudLine());
+    }
+}
+
 /**
  * @brief Überprüft, ob das Spiel beendet werden soll.
  * @return True, wenn das Spiel beendet werden soll, sonst false.
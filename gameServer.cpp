@@ -0,0 +1,409 @@
+#include "headers/gameServer.h"
+#include "headers/threadPool.h"
+#include <cerrno>
+#include <cstring>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+const size_t MAX_OUTPUT = 64 * 1024; ///< so viele Antworten liest ein Client nicht ab: Verbindung beenden
+const size_t ACCEPT_BATCH = 16;      ///< Verbindungen pro Aufwachen, der Rest geht an andere Threads
+const int MAX_EVENTS = 256;
+
+///@brief Antwortwort zu einem Ergebnis von Physics::step()
+const char* outcomeName(Physics::Outcome outcome)
+{
+    switch (outcome)
+    {
+        case Physics::Outcome::MOVED: return "MOVED";
+        case Physics::Outcome::BLOCKED: return "BLOCKED";
+        case Physics::Outcome::NO_LADDER: return "NO_LADDER";
+        case Physics::Outcome::DIED: return "DIED";
+        case Physics::Outcome::QUIT: break;
+    }
+    return "QUIT";
+}
+
+///@brief Meldet fd bei epoll an oder ändert die Ereignisse, data.fd ist fd
+bool watch(int epoll, int operation, int fd, uint32_t events)
+{
+    epoll_event event{};
+    event.events = events;
+    event.data.fd = fd;
+    return epoll_ctl(epoll, operation, fd, &event) == 0;
+}
+
+}
+
+/**
+ * @brief Konstruktor, legt die Arbeitsthreads noch nicht an (siehe run()).
+ * @param cache gemeinsame Karten aller Sitzungen
+ * @param threads Arbeitsthreads, 0 für alle Hardware-Threads
+ */
+GameServer::GameServer(LevelCache& cache, size_t threads)
+        : levels(cache), listenFd(-1), stopFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+{
+    if (threads == 0) threads = ThreadPool::hardwareThreads();
+
+    for (size_t i = 0; i < threads; ++i)
+    {
+        workers.push_back(std::make_unique<Worker>());
+        workers.back()->epoll = epoll_create1(EPOLL_CLOEXEC);
+    }
+}
+
+GameServer::~GameServer()
+{
+    for (auto& worker : workers)
+    {
+        for (auto& entry : worker->sessions) close(entry.first);
+        if (worker->epoll >= 0) close(worker->epoll);
+    }
+
+    if (listenFd >= 0) close(listenFd);
+    if (stopFd >= 0) close(stopFd);
+    if (!unixPath.empty()) unlink(unixPath.c_str());
+}
+
+/**
+ * @brief Wartet auf einem Unix-Socket auf Verbindungen.
+ *
+ * Eine vorhandene Datei unter path wird vorher gelöscht (Socket eines beendeten Servers).
+ *
+ * @param path z.B. "adventure.sock"
+ * @return False, wenn der Socket nicht angelegt werden konnte
+ */
+bool GameServer::listenUnix(const std::string& path)
+{
+    sockaddr_un address{};
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) return false;
+
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) return false;
+
+    unlink(path.c_str());
+    if (bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 || listen(fd, SOMAXCONN) != 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    listenFd = fd;
+    unixPath = path;
+    return true;
+}
+
+/**
+ * @brief Wartet auf TCP-Verbindungen, nur von diesem Rechner (127.0.0.1).
+ * @param port z.B. 7777
+ * @return False, wenn der Port nicht geöffnet werden konnte
+ */
+bool GameServer::listenTcp(uint16_t port)
+{
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) return false;
+
+    int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 || listen(fd, SOMAXCONN) != 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    listenFd = fd;
+    return true;
+}
+
+/**
+ * @brief Bedient Verbindungen, bis stop() aufgerufen wird.
+ *
+ * Der aufrufende Thread ist der erste Arbeitsthread, die anderen werden hier
+ * gestartet und vor der Rückkehr beendet.
+ *
+ * @pre listenUnix() oder listenTcp() war erfolgreich
+ */
+void GameServer::run()
+{
+    if (listenFd < 0 || stopFd < 0) return;
+
+    for (auto& worker : workers)
+    {
+        watch(worker->epoll, EPOLL_CTL_ADD, listenFd, EPOLLIN | EPOLLEXCLUSIVE);
+        watch(worker->epoll, EPOLL_CTL_ADD, stopFd, EPOLLIN);
+    }
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < workers.size(); ++i)
+    {
+        threads.emplace_back(&GameServer::workerLoop, this, std::ref(*workers[i]));
+    }
+
+    workerLoop(*workers[0]);
+
+    for (auto& thread : threads) thread.join();
+}
+
+/**
+ * @brief Beendet run(), aus einem beliebigen Thread.
+ *
+ * Nur ein write(2), darf also auch in einem Signalhandler stehen.
+ */
+void GameServer::stop()
+{
+    uint64_t one = 1;
+    while (write(stopFd, &one, sizeof(one)) < 0 && errno == EINTR) {}
+}
+
+///@brief Summe der Zähler aller Arbeitsthreads, auch während run()
+GameServer::Stats GameServer::getStats() const
+{
+    Stats stats;
+    for (const auto& worker : workers)
+    {
+        stats.accepted += worker->accepted.load(std::memory_order_relaxed);
+        stats.active += worker->active.load(std::memory_order_relaxed);
+        stats.moves += worker->moves.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+/**
+ * @brief Schleife eines Arbeitsthreads: neue Verbindungen annehmen, Sitzungen bedienen.
+ *
+ * Der eventfd von stop() wird nie gelesen, er weckt also alle Threads.
+ */
+void GameServer::workerLoop(Worker& worker)
+{
+    epoll_event events[MAX_EVENTS];
+
+    while (true)
+    {
+        int count = epoll_wait(worker.epoll, events, MAX_EVENTS, -1);
+        if (count < 0)
+        {
+            if (errno == EINTR) continue;
+            return;
+        }
+
+        for (int i = 0; i < count; ++i)
+        {
+            int fd = events[i].data.fd;
+
+            if (fd == stopFd) return;
+            if (fd == listenFd)
+            {
+                acceptConnections(worker);
+                continue;
+            }
+
+            auto found = worker.sessions.find(fd);
+            if (found == worker.sessions.end()) continue;
+
+            if ((events[i].events & (EPOLLERR | EPOLLHUP)) != 0 && (events[i].events & EPOLLIN) == 0)
+            {
+                closeSession(worker, fd);
+            } else if ((events[i].events & EPOLLIN) != 0)
+            {
+                readSession(worker, fd);
+            } else if ((events[i].events & EPOLLOUT) != 0)
+            {
+                writeSession(worker, fd, found->second);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Nimmt bis zu ACCEPT_BATCH Verbindungen an, sie bleiben bei diesem Thread.
+ *
+ * Liegen mehr an, weckt epoll den nächsten Thread, die Sitzungen verteilen sich so
+ * auf alle Kerne.
+ */
+void GameServer::acceptConnections(Worker& worker)
+{
+    for (size_t i = 0; i < ACCEPT_BATCH; ++i)
+    {
+        int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) return; //EAGAIN: ein anderer Thread war schneller; sonst z.B. keine Dateideskriptoren mehr
+
+        int on = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on)); //bei Unix-Sockets wirkungslos
+
+        if (!watch(worker.epoll, EPOLL_CTL_ADD, fd, EPOLLIN))
+        {
+            close(fd);
+            continue;
+        }
+
+        worker.sessions.emplace(fd, Session());
+        worker.accepted.fetch_add(1, std::memory_order_relaxed);
+        worker.active.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Liest alles, was anliegt, beantwortet jede vollständige Zeile und schreibt die Antworten.
+ *
+ * Hat die Gegenseite ihre Seite geschlossen (z.B. "printf 'MAP x.txt\nDD\n' | nc -U -N"),
+ * werden die schon gelesenen Zeilen noch beantwortet und die Sitzung erst beendet,
+ * wenn alle Antworten geschrieben sind.
+ */
+void GameServer::readSession(Worker& worker, int fd)
+{
+    Session& session = worker.sessions.at(fd);
+    char buffer[4096];
+
+    while (true)
+    {
+        ssize_t length = recv(fd, buffer, sizeof(buffer), 0);
+        if (length > 0)
+        {
+            session.input.append(buffer, static_cast<size_t>(length));
+            continue;
+        }
+        if (length == 0)
+        {
+            session.closing = true;
+            break;
+        }
+        if (errno == EINTR) continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+
+        closeSession(worker, fd); //Fehler, die Antworten kommen nicht mehr an
+        return;
+    }
+
+    size_t begin = 0;
+    for (size_t end; (end = session.input.find('\n', begin)) != std::string::npos; begin = end + 1)
+    {
+        handleLine(worker, session, session.input.substr(begin, end - begin));
+    }
+    session.input.erase(0, begin);
+
+    if (session.input.size() > MAX_LINE || session.output.size() > MAX_OUTPUT)
+    {
+        closeSession(worker, fd);
+        return;
+    }
+
+    writeSession(worker, fd, session);
+}
+
+/**
+ * @brief Schreibt die Antworten, so weit der Socket sie annimmt.
+ *
+ * Bleibt etwas übrig, wird EPOLLOUT angemeldet und beim nächsten Mal weitergeschrieben.
+ * Eine Sitzung, die nur noch ihre Antworten loswerden muss, wird danach beendet.
+ */
+void GameServer::writeSession(Worker& worker, int fd, Session& session)
+{
+    size_t written = 0;
+
+    while (written < session.output.size())
+    {
+        ssize_t length = send(fd, session.output.data() + written, session.output.size() - written, MSG_NOSIGNAL);
+        if (length < 0)
+        {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+
+            closeSession(worker, fd);
+            return;
+        }
+        written += static_cast<size_t>(length);
+    }
+
+    session.output.erase(0, written);
+
+    if (session.closing && session.output.empty())
+    {
+        closeSession(worker, fd);
+        return;
+    }
+
+    //nach dem Ende der Eingabe meldet EPOLLIN sich ständig, dann nur noch auf EPOLLOUT warten
+    uint32_t events = 0;
+    if (!session.closing) events |= EPOLLIN;
+    if (!session.output.empty()) events |= EPOLLOUT;
+
+    if (events != session.watched)
+    {
+        watch(worker.epoll, EPOLL_CTL_MOD, fd, events);
+        session.watched = events;
+    }
+}
+
+///@brief Beendet eine Sitzung, ihre Karte bleibt im LevelCache
+void GameServer::closeSession(Worker& worker, int fd)
+{
+    epoll_ctl(worker.epoll, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    worker.sessions.erase(fd);
+    worker.active.fetch_sub(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Beantwortet eine Zeile des Protokolls (siehe Klassenbeschreibung).
+ *
+ * Die erste Anfrage nach einer Karte lädt sie in diesem Thread, die Sitzungen
+ * des Threads warten so lange.
+ */
+void GameServer::handleLine(Worker& worker, Session& session, const std::string& line)
+{
+    std::string text = line;
+    if (!text.empty() && text.back() == '\r') text.pop_back();
+
+    if (text.compare(0, 4, "MAP ") == 0)
+    {
+        session.level = levels.get(text.substr(4));
+        if (!session.level)
+        {
+            session.output.append("ERR Karte unbekannt oder ungültig\n");
+            return;
+        }
+
+        session.state = Physics::start(*session.level);
+        session.output.append("OK " + std::to_string(session.state.x) + " " + std::to_string(session.state.y) + "\n");
+        return;
+    }
+
+    for (char input : text)
+    {
+        if (input == ' ' || (input >= '\t' && input <= '\r')) continue;
+
+        if (!session.level)
+        {
+            session.output.append("ERR kein Spiel, zuerst MAP\n");
+            return;
+        }
+
+        Physics::Outcome outcome = Physics::step(*session.level, session.state, input);
+        worker.moves.fetch_add(1, std::memory_order_relaxed);
+
+        bool won = !session.state.dead && Physics::hasWon(*session.level, session.state);
+        session.output.append(won ? "WON" : outcomeName(outcome));
+        session.output.append(" " + std::to_string(session.state.x) + " " + std::to_string(session.state.y) + "\n");
+
+        if (won || session.state.dead || outcome == Physics::Outcome::QUIT)
+        {
+            session.level.reset();
+        }
+    }
+}
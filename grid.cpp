@@ -0,0 +1,75 @@
+#include "headers/grid.h"
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * @brief Konstruktor für ein leeres Feld (0 x 0).
+ */
+Grid::Grid(): width(0), height(0), stride(0)
+{
+}
+
+/**
+ * @brief Konstruktor, legt ein Feld der Größe rows x cols an.
+ * @param rows Anzahl der Zeilen
+ * @param cols Anzahl der Spalten
+ * @param fill Zeichen, mit dem alle Zellen gefüllt werden
+ */
+Grid::Grid(size_t rows, size_t cols, char fill): Grid()
+{
+    assign(rows, cols, fill);
+}
+
+/**
+ * @brief Legt das Feld neu an und füllt alle Zellen mit fill.
+ *
+ * Der Speicher wird in einem Stück reserviert. Bereits reservierter Speicher wird
+ * wiederverwendet, wenn die neue Karte nicht größer ist.
+ *
+ * @param rows Anzahl der Zeilen
+ * @param cols Anzahl der Spalten
+ * @param fill Zeichen, mit dem alle Zellen gefüllt werden
+ * @post Padding-Zellen am Zeilenende sind Leerzeichen
+ */
+void Grid::assign(size_t rows, size_t cols, char fill)
+{
+    width = cols;
+    height = rows;
+    stride = (width + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+
+    cells.assign(height * stride, ' ');
+
+    if (fill != ' ')
+    {
+        for (size_t r = 0; r < height; ++r)
+        {
+            std::fill_n(row(r), width, fill);
+        }
+    }
+}
+
+/**
+ * @brief Geprüfter Zugriff auf eine Zelle.
+ * @throws std::out_of_range wenn row oder col außerhalb der Karte liegen
+ */
+char& Grid::at(size_t row, size_t col)
+{
+    if (row >= height || col >= width)
+    {
+        throw std::out_of_range("Grid::at");
+    }
+    return (*this)(row, col);
+}
+
+/**
+ * @brief Geprüfter Zugriff auf eine Zelle.
+ * @throws std::out_of_range wenn row oder col außerhalb der Karte liegen
+ */
+char Grid::at(size_t row, size_t col) const
+{
+    if (row >= height || col >= width)
+    {
+        throw std::out_of_range("Grid::at");
+    }
+    return (*this)(row, col);
+}
@@ -0,0 +1,52 @@
+#ifndef PRUEFUNG_AGENTBATCH_H
+#define PRUEFUNG_AGENTBATCH_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "headers/level.h"
+#include "headers/physics.h"
+#include "headers/threadPool.h"
+
+/**
+ * @class AgentBatch
+ * @brief Viele Spieler auf derselben Karte, gespeichert als parallele Felder.
+ *
+ * Statt einem Objekt pro Spieler gibt es je ein Feld für x, y, Zelle in der
+ * Übergangstabelle, Zustand und Züge (Struct of Arrays). Alle Spieler teilen sich ein unveränderliches Level. Pro Takt
+ * bekommt jeder Spieler eine Eingabe, es gelten die Regeln aus Physics, also dieselben
+ * wie im Spiel und in Simulation::run(). Große Mengen werden auf Threads verteilt.
+ */
+class AgentBatch {
+public:
+    /// Zustand eines Spielers, fertige Spieler nehmen keine Eingaben mehr an
+    enum State : uint8_t { RUNNING, WON, DEAD };
+
+    AgentBatch(std::shared_ptr<const Level> sharedLevel, size_t count);
+
+    void reset();
+    void tick(const char* inputs, ThreadPool* pool = nullptr);
+
+    size_t size() const;
+    size_t running() const;
+
+    const std::vector<uint32_t>& getX() const;
+    const std::vector<uint32_t>& getY() const;
+    const std::vector<uint8_t>& getState() const;
+    const std::vector<uint32_t>& getSteps() const;
+
+private:
+    static constexpr size_t MIN_PARALLEL = 4096; ///< darunter lohnen sich Threads nicht
+    static constexpr size_t BLOCK = 64;          ///< Bereichsgrenzen, damit sich Threads keine Cachezeile teilen
+
+    std::shared_ptr<const Level> level;
+
+    std::vector<uint32_t> x, y, cell;
+    std::vector<uint8_t> state;
+    std::vector<uint32_t> steps;
+
+    void tickRange(const char* inputs, size_t first, size_t last);
+};
+
+
+#endif //PRUEFUNG_AGENTBATCH_H
@@ -0,0 +1,166 @@
+#ifndef PRUEFUNG_BUILTINMAP_H
+#define PRUEFUNG_BUILTINMAP_H
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include "headers/mapValidator.h"
+
+/**
+ * @struct StaticMapCheck
+ * @brief Die Regeln von MapValidator zur Übersetzungszeit, für eingebaute Karten.
+ *
+ * Geht die Karte Spalte für Spalte mit demselben Zustand (letzte Plattform, offene
+ * Leiter) durch wie MapValidator::consumeRow() und findet dieselben Fehler an denselben
+ * Stellen: den ersten in Zeilenreihenfolge, dazu das letzte S und O. Ohne SIMD und
+ * ohne Speicher pro Spalte, dafür constexpr, damit eine ungültige eingebaute Karte
+ * schon beim Übersetzen mit static_assert auffällt.
+ */
+struct StaticMapCheck {
+    using Error = ValidationResult::Error;
+    static constexpr size_t NO_POS = ValidationResult::NO_POS;
+
+    Error error = Error::NONE;
+    size_t errorRow = NO_POS, errorCol = NO_POS;
+    size_t startRow = NO_POS, startCol = NO_POS;
+    size_t goalRow = NO_POS, goalCol = NO_POS;
+
+    constexpr bool ok() const { return error == Error::NONE; }
+
+    /**
+     * @brief Prüft eine Karte.
+     * @param cells height x width Zeichen, Zeile für Zeile, unbereinigt
+     * @return Ergebnis; MISSING_SYMBOL, wenn sonst alles stimmt, aber S oder O fehlt
+     */
+    static constexpr StaticMapCheck run(std::string_view cells, size_t height, size_t width, size_t maxSpace,
+                                        size_t playerHeight)
+    {
+        StaticMapCheck result;
+
+        for (size_t col = 0; col < width; ++col)
+        {
+            size_t lastPlatform = NO_POS, pendingLadder = NO_POS;
+
+            for (size_t row = 0; row < height; ++row)
+            {
+                switch (cells[row * width + col])
+                {
+                    case '-':
+                        if (row < playerHeight) result.record(Error::PLATFORM_ROW, row, col);
+                        if (lastPlatform != NO_POS && row - lastPlatform <= maxSpace)
+                        {
+                            result.record(Error::PLATFORM_SPACE, lastPlatform, col);
+                        }
+                        lastPlatform = row;
+                        pendingLadder = NO_POS;
+                        break;
+                    case ' ':
+                        if (pendingLadder != NO_POS)
+                        {
+                            result.record(Error::LADDER_END, pendingLadder, col);
+                            pendingLadder = NO_POS;
+                        }
+                        break;
+                    case 'H':
+                    {
+                        char top = row > 0 ? clean(cells[(row - 1) * width + col]) : ' ';
+                        if (top != '-' && top != 'H' && top != 'O')
+                        {
+                            result.record(Error::LADDER_START, row, col);
+                        } else if (pendingLadder == NO_POS)
+                        {
+                            pendingLadder = row;
+                        }
+                        break;
+                    }
+                    case 'S':
+                    case 'O':
+                        if (row + 2 >= height || cells[(row + 2) * width + col] != '-')
+                        {
+                            result.record(Error::SYMBOL_GROUND, row, col);
+                        }
+                        if (cells[row * width + col] == 'S')
+                        {
+                            result.recordLast(result.startRow, result.startCol, row, col);
+                        } else {
+                            result.recordLast(result.goalRow, result.goalCol, row, col);
+                        }
+                        break;
+                    default: //andere Zeichen unterbrechen eine Leiter nicht
+                        break;
+                }
+            }
+
+            if (pendingLadder != NO_POS) result.record(Error::LADDER_END, pendingLadder, col);
+        }
+
+        if (result.ok() && (result.startRow == NO_POS || result.goalRow == NO_POS))
+        {
+            result.record(Error::MISSING_SYMBOL, 0, 0);
+        }
+
+        return result;
+    }
+
+    /// Zeichen nach der Bereinigung: nur '-', 'H' und 'O' bleiben, alles andere wird ' '
+    static constexpr char clean(char cell)
+    {
+        return (cell == '-' || cell == 'H' || cell == 'O') ? cell : ' ';
+    }
+
+    /// bereinigte Zellen einer Karte mit N Zellen, wie sie nach der Prüfung im Level stehen
+    template <size_t N>
+    static constexpr std::array<char, N> cleanCells(std::string_view cells)
+    {
+        std::array<char, N> cleaned{};
+        for (size_t i = 0; i < N; ++i)
+        {
+            cleaned[i] = clean(cells[i]);
+        }
+        return cleaned;
+    }
+
+private:
+    /// wie ValidationResult::recordError(): der erste Fehler in Zeilenreihenfolge gewinnt
+    constexpr void record(Error kind, size_t row, size_t col)
+    {
+        if (error == Error::NONE || row < errorRow || (row == errorRow && col < errorCol))
+        {
+            error = kind;
+            errorRow = row;
+            errorCol = col;
+        }
+    }
+
+    /// wie ValidationResult::recordStart(): das letzte Symbol in Zeilenreihenfolge gewinnt
+    static constexpr void recordLast(size_t& lastRow, size_t& lastCol, size_t row, size_t col)
+    {
+        if (lastRow == NO_POS || row > lastRow || (row == lastRow && col > lastCol))
+        {
+            lastRow = row;
+            lastCol = col;
+        }
+    }
+};
+
+/**
+ * @struct BuiltinMap
+ * @brief Eine Karte, die mit tools/embedMaps in das Programm eingebaut ist.
+ *
+ * Alle Daten sind constexpr und schon beim Übersetzen mit den Standardregeln
+ * (ClassicRules) geprüft (StaticMapCheck), die Lösung hat embedMaps beim Erzeugen
+ * berechnet. Eine eingebaute Karte wird also ohne Datei, ohne Zerlegen und ohne
+ * Prüfung geladen (Level::loadBuiltin()). Für andere Regelprofile bleiben die
+ * unbereinigten Zellen, sie werden dann beim Laden geprüft.
+ */
+struct BuiltinMap {
+    std::string_view name;     ///< Dateiname, unter dem sie im Menü steht, z.B. "spiel.txt"
+    size_t height, width;
+    std::string_view cells;    ///< height x width unbereinigte Zellen, Zeile für Zeile
+    std::string_view cleaned;  ///< height x width bereinigte Zellen, Zeile für Zeile
+    StaticMapCheck check;      ///< Start- und Zielsymbol
+    std::string_view solution; ///< kürzeste Eingabefolge zum Ziel
+};
+
+
+#endif //PRUEFUNG_BUILTINMAP_H
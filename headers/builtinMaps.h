@@ -0,0 +1,122 @@
+#ifndef PRUEFUNG_BUILTINMAPS_H
+#define PRUEFUNG_BUILTINMAPS_H
+
+//Erzeugt von tools/embedMaps, nicht von Hand ändern (siehe txt/COMPILE.txt).
+
+#include <array>
+#include <string_view>
+#include "headers/builtinMap.h"
+#include "headers/ruleProfile.h"
+
+namespace builtin {
+
+inline constexpr std::string_view SPIEL_CELLS =
+        "                              "
+        " S                       O    "
+        "                              "
+        "---------   -------- -------  "
+        "    H                 H       "
+        "    H                 H       "
+        "    H                 H       "
+        "    H            ------------ "
+        " --------         H           "
+        "       H          H           "
+        "       H          H           "
+        "       H          H           "
+        "      ----------------        "
+        "                              "
+        "                              ";
+inline constexpr StaticMapCheck SPIEL_CHECK =
+        StaticMapCheck::run(SPIEL_CELLS, 15, 30, ClassicRules::MAX_SPACE, ClassicRules::PLAYER_HEIGHT);
+static_assert(SPIEL_CHECK.ok(), "maps/spiel.txt ist keine gültige Karte");
+inline constexpr auto SPIEL_CLEANED = StaticMapCheck::cleanCells<15 * 30>(SPIEL_CELLS);
+
+inline constexpr std::string_view SPIEL2_CELLS =
+        "                                        "
+        "-------------- ------------------------ "
+        "  H             H                     H "
+        "  H             H                     H "
+        "  H             H                     H "
+        "----------     ---------              H "
+        "        H           H                 H "
+        "        H        O  H                 H "
+        "        H           H                 H "
+        "------------  -------------           H "
+        "  H                                   H "
+        "  H     S                             H "
+        "  H                                   H "
+        "--------------                        H "
+        "    H                                 H "
+        "    H                                 H "
+        "    H                                 H "
+        "----------------------------------------"
+        "                                        "
+        "                                        ";
+inline constexpr StaticMapCheck SPIEL2_CHECK =
+        StaticMapCheck::run(SPIEL2_CELLS, 20, 40, ClassicRules::MAX_SPACE, ClassicRules::PLAYER_HEIGHT);
+static_assert(SPIEL2_CHECK.ok(), "maps/spiel2.txt ist keine gültige Karte");
+inline constexpr auto SPIEL2_CLEANED = StaticMapCheck::cleanCells<20 * 40>(SPIEL2_CELLS);
+
+inline constexpr std::string_view SPIEL3_CELLS =
+        "                                        "
+        "------------- --------------------------"
+        "  H             H                     H "
+        "  H             H                     H "
+        "  H             H                     H "
+        "----------     ---------              H "
+        "        H           H                 H "
+        "        H           H                 H "
+        "        H           H                 H "
+        "------------  -------------           H "
+        "  H                                   H "
+        "  H                                   H "
+        "  H                          O        H "
+        "--------------                        H "
+        "    H                   ------        H "
+        "    H                                 H "
+        "    H                                 H "
+        "-----------------------               H "
+        "  H             H                     H "
+        "  H             H                     H "
+        "  H             H                     H "
+        "----------     ---------              H "
+        "        H                             H "
+        "        H                             H "
+        "        H                             H "
+        "        H                             H "
+        "        H                             H "
+        "      S H                             H "
+        "        H                             H "
+        "--------------                        H "
+        "    H                                 H "
+        "    H                                 H "
+        "    H                                 H "
+        "----------------------------------------"
+        "                                        "
+        "                                        "
+        "                                        "
+        "                                        "
+        "                                        "
+        "                                        ";
+inline constexpr StaticMapCheck SPIEL3_CHECK =
+        StaticMapCheck::run(SPIEL3_CELLS, 40, 40, ClassicRules::MAX_SPACE, ClassicRules::PLAYER_HEIGHT);
+static_assert(SPIEL3_CHECK.ok(), "maps/spiel3.txt ist keine gültige Karte");
+inline constexpr auto SPIEL3_CLEANED = StaticMapCheck::cleanCells<40 * 40>(SPIEL3_CELLS);
+
+}
+
+/// alle eingebauten Karten, in der Reihenfolge für das Menü
+inline constexpr std::array<BuiltinMap, 3> BUILTIN_MAPS{{
+        {"spiel.txt", 15, 30, builtin::SPIEL_CELLS, {builtin::SPIEL_CLEANED.data(), builtin::SPIEL_CLEANED.size()},
+         builtin::SPIEL_CHECK,
+         "DDDFDDDDDDDDDDDDDDFDDDDFDDD"},
+        {"spiel2.txt", 20, 40, builtin::SPIEL2_CELLS, {builtin::SPIEL2_CLEANED.data(), builtin::SPIEL2_CLEANED.size()},
+         builtin::SPIEL2_CHECK,
+         "DDDDDDDDDDDDDDDDDDDDDDDDDDDDDDFAAAAAAAAAAAAAAAAAAAAAAFAADDD"},
+        {"spiel3.txt", 40, 40, builtin::SPIEL3_CELLS, {builtin::SPIEL3_CLEANED.data(), builtin::SPIEL3_CLEANED.size()},
+         builtin::SPIEL3_CHECK,
+         "DDDDDDDDDDDDDDDDDDDDDDDDDDDDDDDDFAAAAAAAAAAAAAAAAAAAAAAFDDDDDDDDDDDDD"},
+}};
+
+
+#endif //PRUEFUNG_BUILTINMAPS_H
@@ -0,0 +1,44 @@
+#ifndef PRUEFUNG_CAPTURERENDERER_H
+#define PRUEFUNG_CAPTURERENDERER_H
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include "headers/renderer.h"
+
+/**
+ * @class CaptureRenderer
+ * @brief Nimmt die Bilder in einer Datei im asciicast-Format (Version 2) auf (RenderSink::CAPTURE).
+ *
+ * Gezeichnet wird wie vom Renderer in einem Terminal mit rows x cols Zeichen, auch
+ * mit Ausschnitt und Änderungsbildern. Statt ins Terminal wird jedes Bild als ein
+ * Ereignis mit der Zeit seit dem Start in die Datei geschrieben:
+ *
+ *   {"version": 2, "width": 80, "height": 24, "timestamp": 1706712300}
+ *   [0.000000, "o", "\u001b[H\u001b[2J..."]
+ *   [0.412345, "o", "\u001b[7;12HP..."]
+ *
+ * Zeilenenden werden wie von einem Terminal als "\r\n" geschrieben. Die Datei lässt
+ * sich mit play() (tools/replay --cast) oder asciinema abspielen, ohne das Spiel
+ * noch einmal zu simulieren.
+ */
+class CaptureRenderer final : public Renderer {
+public:
+    static constexpr const char* EXTENSION = ".cast";
+
+    CaptureRenderer(const std::string& path, unsigned short rows, unsigned short cols);
+
+    bool isOpen() const;
+
+    static bool play(const std::string& path, int fileDescriptor);
+
+protected:
+    void output(const std::string& bytes) override;
+
+private:
+    std::ofstream file;
+    std::chrono::steady_clock::time_point start;
+};
+
+
+#endif //PRUEFUNG_CAPTURERENDERER_H
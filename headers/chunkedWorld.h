@@ -0,0 +1,110 @@
+#ifndef PRUEFUNG_CHUNKEDWORLD_H
+#define PRUEFUNG_CHUNKEDWORLD_H
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "headers/level.h"
+#include "headers/platformIndex.h"
+#include "headers/threadPool.h"
+
+/**
+ * @class ChunkedWorld
+ * @brief Eine Karte, die größer als der Arbeitsspeicher sein darf, in Blöcken nachgeladen.
+ *
+ * Die Karte liegt als .achunk-Datei vor (siehe convert()): quadratische Blöcke mit
+ * chunkSize x chunkSize Zellen, bereinigt und geprüft. Blöcke aus nur Leerzeichen werden
+ * nicht gespeichert. Beim Spielen werden Blöcke bei Bedarf mit pread gelesen und in
+ * einem LRU-Cache gehalten, der höchstens memoryBudget Bytes belegt (mindestens ein
+ * Block bleibt immer geladen). prefetch() lädt den nächsten Block in Laufrichtung
+ * in einem eigenen Thread, damit der Spieler beim Überschreiten einer Blockgrenze
+ * nicht auf die Platte warten muss.
+ *
+ * Bietet die Schnittstelle, die PhysicsRules erwartet. Zeilen sind wie im Level
+ * Kartenzeilen, Positionen {Zeile, Spalte} des Spielers.
+ *
+ * Die Suche nach Plattformen ist nicht threadsicher, d.h. pro ChunkedWorld spielt
+ * nur ein Thread; nur das Nachladen im Hintergrund läuft parallel.
+ */
+class ChunkedWorld {
+public:
+    static constexpr size_t NONE = PlatformIndex::NONE;
+    static constexpr size_t DEFAULT_CHUNK = 256;
+    static constexpr const char* EXTENSION = ".achunk";
+
+    /// Zähler für den Cache, alle Zeiten in Nanosekunden
+    struct Stats {
+        size_t hits = 0, misses = 0;  ///< Zugriffe auf einen anderen Block als den letzten
+        size_t prefetched = 0, evicted = 0;
+        uint64_t missNsTotal = 0, missNsMax = 0; ///< Wartezeit des Spielers auf einen Block
+        size_t residentBytes = 0, peakBytes = 0;
+    };
+
+    explicit ChunkedWorld(size_t memoryBudget);
+    ~ChunkedWorld();
+
+    ChunkedWorld(const ChunkedWorld&) = delete;
+    ChunkedWorld& operator=(const ChunkedWorld&) = delete;
+
+    bool open(const std::string& path);
+
+    static LoadReport convert(const std::string& textPath, const std::string& chunkPath, size_t chunkSize,
+                              RuleProfile rules);
+
+    size_t width() const;
+    size_t height() const;
+    size_t getChunkSize() const;
+    RuleProfile getRules() const;
+    const std::array<size_t, 2>& getStartPos() const;
+    const std::array<size_t, 2>& getGoalPos() const;
+
+    char cell(size_t row, size_t col) const;
+    bool isLadder(size_t col, size_t row) const;
+    size_t platformAtOrBelow(size_t col, size_t row) const;
+    size_t platformAtOrAbove(size_t col, size_t row) const;
+
+    void prefetch(size_t col, size_t row) const;
+    Stats getStats() const;
+
+private:
+    using Cells = std::shared_ptr<const std::vector<char>>;
+
+    struct Entry {
+        Cells cells;        ///< leer, solange der Block noch gelesen wird
+        std::list<size_t>::iterator age;
+    };
+
+    size_t budget;
+    int fd = -1;
+    size_t rows = 0, cols = 0, chunkSize = 0, chunkRows = 0, chunkCols = 0;
+    std::array<size_t, 2> startPos{{0, 0}}, goalPos{{0, 0}};
+    RuleProfile rules = RuleProfile::CLASSIC;
+    std::vector<uint64_t> offsets; ///< Lage jedes Blocks in der Datei, 0 für einen leeren Block
+
+    mutable std::mutex mutex;
+    mutable std::condition_variable loaded;
+    mutable std::unordered_map<size_t, Entry> chunks;
+    mutable std::list<size_t> lru; ///< geladene Blöcke, zuletzt benutzter vorne
+    mutable Stats stats;
+
+    //nur vom spielenden Thread benutzt, spart Sperre und Suche innerhalb eines Blocks
+    mutable size_t lastChunk = NONE;
+    mutable Cells lastCells;
+
+    std::unique_ptr<ThreadPool> prefetcher; ///< zuletzt, damit er vor allem anderen beendet wird
+
+    size_t chunkOf(size_t row, size_t col) const;
+    const char* acquire(size_t chunk) const;
+    Cells read(size_t chunk) const;
+    void store(size_t chunk, Cells cells) const;
+};
+
+
+#endif //PRUEFUNG_CHUNKEDWORLD_H
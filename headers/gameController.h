@@ -1,8 +1,32 @@
 #ifndef PRUEFUNG_GAMECONTROLLER_H
 #define PRUEFUNG_GAMECONTROLLER_H
 
+#include <chrono>
+#include <memory>
+#include <vector>
+#include "headers/inputLog.h"
 #include "headers/player.h"
 #include "headers/map.h"
+#include "headers/renderer.h"
+#include "headers/terminalInput.h"
+
+/**
+ * @struct GameOptions
+ * @brief Einstellungen aus der Kommandozeile.
+ */
+struct GameOptions {
+    size_t validationThreads = 1; ///< Threads für die Kartenprüfung, 0 = alle Hardware-Threads
+    RuleProfile rules = RuleProfile::CLASSIC; ///< Regelprofil für alle Karten
+    RenderSink render = RenderSink::TERMINAL; ///< wohin die Bilder gehen
+    std::string capturePath; ///< Datei für RenderSink::CAPTURE
+    bool fullMap = false; ///< immer die ganze Karte zeichnen statt eines Ausschnitts um den Spieler
+    size_t deadZone = Renderer::AUTO_DEAD_ZONE; ///< Abstand zum Rand des Ausschnitts, ab dem er mitläuft
+    bool lineMode = false; ///< Züge zeilenweise lesen (mit Enter), auch wenn die Eingabe ein Terminal ist
+    size_t tickMs = 20; ///< Länge eines Spieltakts im Echtzeitmodus in Millisekunden
+    bool debug = false; ///< Latenz von der Taste bis zum Bild nach jedem Spiel ausgeben
+    bool hud = false; ///< nach jedem Zug eine Zeile mit den Messwerten des Profilers ausgeben
+    std::string recordDirectory = "logs/"; ///< jedes Spiel hier aufzeichnen, wenn der Ordner existiert; leer = nie
+};
 
 /**
  * @class GameController
@@ -10,10 +34,22 @@
  *
  * GameController initialisiert das Spiel, verarbeitet Benutzereingaben,
  * aktualisiert den Spielstatus und kontrolliert den Spielablauf.
+ *
+ * Ist die Eingabe ein Terminal, laufen die Züge in Echtzeit: Tasten werden im
+ * Rohmodus ohne Enter gelesen, pro Spieltakt wird höchstens ein Zug ausgeführt und
+ * nur bei einer Änderung gezeichnet. Aus Pipes und Dateien (oder mit lineMode)
+ * wird wie bisher blockierend Zeile für Zeile gelesen.
+ *
+ * Gibt es den Ordner für Aufzeichnungen, wird jedes Spiel als InputLog gespeichert
+ * und kann mit tools/replay nachgespielt werden.
+ *
+ * Bilder und Meldungen zum Spiel gehen an ein RenderBackend, das beim Start gewählt
+ * wird: das Terminal, eine Aufnahme (CaptureRenderer) oder nichts (NullRenderer).
+ * Menü und Ergebnis stehen immer auf std::cout.
  */
 class GameController {
 public:
-    GameController();
+    explicit GameController(const GameOptions& options = GameOptions());
     void processInput();
     bool exit() const;
 
@@ -22,10 +58,28 @@ private:
 
     void startMenu();
     void playerMoveLoop();
+    void lineMoveLoop();
+    void realtimeMoveLoop(const TerminalInput& terminal);
+    void move(char input);
+    void drawPlayer();
+    void startRecording();
+    void finishRecording();
+    void reportLatency();
+    void showHud() const;
     void selectMapLoop();
     void gameReset();
     bool selectMap(int index);
 
+    bool lineMode, debug, hud;
+    std::chrono::milliseconds tick;
+    std::vector<double> latencies; ///< Millisekunden von der Taste bis zum fertigen Bild, im letzten Spiel
+
+    std::string recordDirectory;
+    bool recording;
+    InputLog log;
+    TerminalInput::Clock::time_point gameStart;
+
+    std::unique_ptr<RenderBackend> renderer;
     Map map;
     Player player;
 };
@@ -0,0 +1,86 @@
+#ifndef PRUEFUNG_GAMESERVER_H
+#define PRUEFUNG_GAMESERVER_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <sys/epoll.h>
+#include "headers/levelCache.h"
+#include "headers/physics.h"
+
+/**
+ * @class GameServer
+ * @brief Viele Spieler gleichzeitig über einen lokalen Socket (Unix-Socket oder TCP auf 127.0.0.1).
+ *
+ * Ein Arbeitsthread pro Kern, jeder mit eigener epoll-Schleife. Alle warten auf
+ * demselben Socket (EPOLLEXCLUSIVE), eine Verbindung bleibt bei dem Thread, der sie
+ * angenommen hat. Eine Sitzung besteht nur aus PlayerState, Ein- und Ausgabepuffer
+ * und einem Verweis auf die gemeinsame Karte im LevelCache, es wird nichts gezeichnet.
+ *
+ * Protokoll, Zeilen mit '\n':
+ *
+ *   MAP spiel.txt        ->  OK x y            Spiel auf der Karte beginnen, Startposition
+ *                        ->  ERR Meldung       Karte unbekannt oder ungültig
+ *   D (oder DDAF...)     ->  je Zeichen eine Zeile: ERGEBNIS x y
+ *
+ * ERGEBNIS ist MOVED, BLOCKED, NO_LADDER, DIED, QUIT oder WON. Nach DIED, QUIT und WON
+ * ist das Spiel vorbei, weitere Züge ergeben ERR, bis wieder MAP kommt. Leerraum in
+ * einer Zugzeile zählt nicht. Eine Zeile über MAX_LINE Bytes beendet die Verbindung.
+ */
+class GameServer {
+public:
+    static constexpr size_t MAX_LINE = 4096;
+
+    /// Zähler über alle Arbeitsthreads
+    struct Stats {
+        uint64_t accepted = 0, active = 0, moves = 0;
+    };
+
+    GameServer(LevelCache& cache, size_t threads);
+    ~GameServer();
+
+    GameServer(const GameServer&) = delete;
+    GameServer& operator=(const GameServer&) = delete;
+
+    bool listenUnix(const std::string& path);
+    bool listenTcp(uint16_t port);
+
+    void run();
+    void stop();
+
+    Stats getStats() const;
+
+private:
+    struct Session {
+        std::shared_ptr<const Level> level; ///< nullptr, solange kein Spiel läuft
+        PlayerState state;
+        std::string input, output;
+        uint32_t watched = EPOLLIN; ///< bei epoll angemeldete Ereignisse, EPOLLOUT solange output wartet
+        bool closing = false;       ///< Gegenseite hat ihre Seite geschlossen, nach den Antworten beenden
+    };
+
+    struct Worker {
+        int epoll = -1;
+        std::unordered_map<int, Session> sessions;
+        std::atomic<uint64_t> accepted{0}, active{0}, moves{0};
+    };
+
+    LevelCache& levels;
+    int listenFd, stopFd;
+    std::string unixPath; ///< wird beim Beenden gelöscht
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    void workerLoop(Worker& worker);
+    void acceptConnections(Worker& worker);
+    void readSession(Worker& worker, int fd);
+    void writeSession(Worker& worker, int fd, Session& session);
+    void closeSession(Worker& worker, int fd);
+    void handleLine(Worker& worker, Session& session, const std::string& line);
+};
+
+
+#endif //PRUEFUNG_GAMESERVER_H
@@ -0,0 +1,129 @@
+#ifndef PRUEFUNG_GRID_H
+#define PRUEFUNG_GRID_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class Grid
+ * @brief Zweidimensionales Zeichenfeld mit zusammenhängendem Speicher.
+ *
+ * Alle Zeilen liegen hintereinander in einem einzigen Speicherblock (row-major).
+ * Jede Zeile ist STRIDE Zeichen lang (Breite auf ALIGNMENT aufgerundet), die
+ * überzähligen Zellen am Zeilenende sind immer Leerzeichen.
+ */
+class Grid {
+public:
+    /**
+     * @class ColumnView
+     * @brief Sicht auf eine einzelne Spalte, für vertikale Durchläufe.
+     *
+     * Der Zugriff auf die nächste Zeile ist nur ein Zeigersprung um STRIDE.
+     */
+    class ColumnView {
+    public:
+        ColumnView(const char* first, size_t step, size_t rows);
+
+        char operator[](size_t row) const;
+        size_t size() const;
+
+    private:
+        const char* top;
+        size_t stride, length;
+    };
+
+    Grid();
+    Grid(size_t rows, size_t cols, char fill = ' ');
+
+    void assign(size_t rows, size_t cols, char fill = ' ');
+
+    char& at(size_t row, size_t col);
+    char at(size_t row, size_t col) const;
+
+    char& operator()(size_t row, size_t col);
+    char operator()(size_t row, size_t col) const;
+
+    char* row(size_t index);
+    const char* row(size_t index) const;
+    ColumnView column(size_t col) const;
+
+    size_t getWidth() const;
+    size_t getHeight() const;
+    size_t getStride() const;
+    bool empty() const;
+
+    static constexpr size_t ALIGNMENT = 16;
+
+private:
+    size_t width, height, stride;
+    std::vector<char> cells;
+};
+
+inline Grid::ColumnView::ColumnView(const char* first, size_t step, size_t rows)
+        : top(first), stride(step), length(rows)
+{
+}
+
+///@brief ungeprüfter Zugriff auf die Zeile row dieser Spalte
+inline char Grid::ColumnView::operator[](size_t row) const
+{
+    return top[row * stride];
+}
+
+///@brief Anzahl der Zeilen in der Spalte
+inline size_t Grid::ColumnView::size() const
+{
+    return length;
+}
+
+///@brief ungeprüfter Zugriff, row und col müssen innerhalb der Karte liegen
+inline char& Grid::operator()(size_t row, size_t col)
+{
+    return cells[row * stride + col];
+}
+
+///@brief ungeprüfter Zugriff, row und col müssen innerhalb der Karte liegen
+inline char Grid::operator()(size_t row, size_t col) const
+{
+    return cells[row * stride + col];
+}
+
+///@brief Zeiger auf den Anfang der Zeile index
+inline char* Grid::row(size_t index)
+{
+    return cells.data() + index * stride;
+}
+
+///@brief Zeiger auf den Anfang der Zeile index
+inline const char* Grid::row(size_t index) const
+{
+    return cells.data() + index * stride;
+}
+
+///@brief Spaltensicht für vertikale Durchläufe
+inline Grid::ColumnView Grid::column(size_t col) const
+{
+    return ColumnView(cells.data() + col, stride, height);
+}
+
+inline size_t Grid::getWidth() const
+{
+    return width;
+}
+
+inline size_t Grid::getHeight() const
+{
+    return height;
+}
+
+inline size_t Grid::getStride() const
+{
+    return stride;
+}
+
+inline bool Grid::empty() const
+{
+    return width == 0 || height == 0;
+}
+
+#endif //PRUEFUNG_GRID_H
@@ -0,0 +1,59 @@
+#ifndef PRUEFUNG_INPUTLOG_H
+#define PRUEFUNG_INPUTLOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "headers/level.h"
+#include "headers/simulation.h"
+
+/**
+ * @struct InputRun
+ * @brief Eine Folge gleicher Eingaben hintereinander.
+ */
+struct InputRun {
+    char input = 0;
+    uint32_t count = 0;
+    uint32_t startMs = 0;    ///< Zeit der ersten Eingabe seit Spielbeginn
+    uint32_t durationMs = 0; ///< Zeit von der ersten bis zur letzten Eingabe der Folge
+};
+
+/**
+ * @class InputLog
+ * @brief Aufzeichnung eines Spiels: Karte, Startzustand, Eingaben und Endzustand.
+ *
+ * Mit der Aufzeichnung kann ein Spiel genau nachgespielt werden, entweder in der
+ * aufgenommenen Geschwindigkeit oder ohne Ausgabe so schnell wie möglich
+ * (tools/replay). Die Eingaben werden lauflängenkodiert, eine gehaltene Taste
+ * kostet also nur einen Eintrag. Innerhalb einer Folge werden die Eingaben beim
+ * Abspielen in der aufgenommenen Geschwindigkeit gleichmäßig verteilt.
+ *
+ * Dateiformat .alog: "ALOG", Version (1 Byte), Regelprofil (1 Byte), Kartenhash (8 Byte, little endian),
+ * danach nur noch vorzeichenlose LEB128-Zahlen: Länge und Zeichen des Kartennamens,
+ * Start x/y, ein Byte Endzustand (1 = gewonnen, 2 = tot), Ende x/y, Züge, Anzahl der
+ * Folgen und pro Folge ein Byte Eingabe, Anzahl, Abstand des Anfangs zum Anfang
+ * der vorherigen Folge in ms, Dauer in ms.
+ */
+class InputLog {
+public:
+    static constexpr const char* EXTENSION = ".alog";
+
+    std::string mapName;
+    uint64_t mapHash = 0;
+    RuleProfile rules = RuleProfile::CLASSIC; ///< Regeln, mit denen gespielt wurde
+    size_t startX = 0, startY = 0;
+    SimulationResult end; ///< Zustand, als das Spiel zu Ende war
+    std::vector<InputRun> runs;
+
+    void record(char input, uint32_t timeMs);
+    std::string inputs() const;
+
+    bool write(const std::string& path) const;
+    static bool read(const std::string& path, InputLog& log);
+
+    static uint64_t hashLevel(const Level& level);
+};
+
+
+#endif //PRUEFUNG_INPUTLOG_H
@@ -0,0 +1,68 @@
+#ifndef PRUEFUNG_LEVEL_H
+#define PRUEFUNG_LEVEL_H
+
+#include <array>
+#include <string>
+#include <vector>
+#include "headers/builtinMap.h"
+#include "headers/grid.h"
+#include "headers/mapLoader.h"
+#include "headers/mapValidator.h"
+#include "headers/platformIndex.h"
+#include "headers/ruleProfile.h"
+#include "headers/threadPool.h"
+#include "headers/tilePlanes.h"
+#include "headers/transitionTable.h"
+
+/**
+ * @struct LoadReport
+ * @brief Ergebnis beim Laden einer Karte, enthält alles für die Fehlermeldungen.
+ */
+struct LoadReport {
+    enum class Status { OK, OPEN_FAILED, BAD_DIMENSION, INVALID, UNREACHABLE, OUT_OF_MEMORY };
+
+    Status status = Status::OK;
+    MapLoader::DimensionError heightError = MapLoader::DimensionError::NONE;
+    MapLoader::DimensionError widthError = MapLoader::DimensionError::NONE;
+    ValidationResult validation;
+    bool fromCache = false;
+    bool builtin = false;      ///< eingebaute Karte (BuiltinMap), ohne Datei geladen
+    bool incremental = false;  ///< Level::reloadText() hat nur die Änderungen übernommen
+    size_t changedRows = 0;    ///< bei reloadText(): geänderte Zeilen, 0 = Karte unverändert
+    size_t checkedColumns = 0; ///< bei reloadText(): neu geprüfte Spalten
+
+    bool ok() const;
+};
+
+/**
+ * @struct Level
+ * @brief Eine geladene und geprüfte Karte mit allem, was zum Spielen gebraucht wird.
+ *
+ * Wird nach dem Laden nicht mehr verändert und zwischen Map und Player geteilt, im
+ * Server (LevelCache) zwischen allen Sitzungen auf derselben Karte.
+ */
+struct Level {
+    /// Jede Zelle kann eine Plattform sein, Plattformen werden als uint32_t gezählt und
+    /// ihre INPUTS Übergänge müssen unter den Codes der Übergangstabelle bleiben. Ob eine
+    /// Karte in den Speicher passt, entscheidet erst das Laden (OUT_OF_MEMORY).
+    /// Größere Karten nur mit ChunkedWorld (tools/chunkWorld).
+    static constexpr size_t MAX_CELLS = TransitionTable::NO_CELL / TransitionTable::INPUTS;
+
+    Grid grid;
+    PlatformIndex platforms;
+    TilePlanes planes; ///< nur während buildTransitions() und nur bei hohen Karten, sonst leer
+    TransitionTable transitions; ///< wird beim Laden aus dem Plattformindex berechnet
+    std::array<size_t, 2> startPos{{0, 0}}, goalPos{{0, 0}}; ///< {Zeile, Spalte} des Spielers
+    std::string solution; ///< kürzeste Eingabefolge zum Ziel, ihre Länge ist das Par der Karte
+    RuleProfile rules = RuleProfile::CLASSIC; ///< Regeln für Prüfung, Übergangstabelle und Lösung
+
+    static LoadReport loadText(const std::string& path, Level& level, RuleProfile rules, ThreadPool* pool = nullptr);
+    static LoadReport loadBuiltin(const BuiltinMap& map, Level& level, RuleProfile rules, ThreadPool* pool = nullptr);
+    static LoadReport reloadText(const std::string& path, const Level* previous, Grid& source, Level& level,
+                                 RuleProfile rules, ThreadPool* pool = nullptr);
+    static void buildTransitions(Level& level, ThreadPool* pool = nullptr, const Level* previous = nullptr,
+                                 const std::vector<uint8_t>* dirtyBlocks = nullptr);
+};
+
+
+#endif //PRUEFUNG_LEVEL_H
@@ -0,0 +1,47 @@
+#ifndef PRUEFUNG_LEVELCACHE_H
+#define PRUEFUNG_LEVELCACHE_H
+
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "headers/level.h"
+
+/**
+ * @class LevelCache
+ * @brief Lädt jede Karte eines Ordners höchstens einmal und teilt sie zwischen allen Spielern.
+ *
+ * Für den Server (GameServer): alle Sitzungen auf derselben Karte teilen einen
+ * unveränderlichen Level über std::shared_ptr, ein Spieler braucht nur seinen
+ * PlayerState. Geladen wird wie im Spiel (Map): eine eingebaute Karte, wenn es keine
+ * Datei mit ihrem Namen gibt, sonst die .amap-Datei neben der Karte oder die .txt-Datei,
+ * deren Prüfung dann als .amap gespeichert wird.
+ *
+ * Fragen mehrere Threads gleichzeitig nach einer noch nicht geladenen Karte, lädt
+ * sie der erste, die anderen warten auf sein Ergebnis. Gemerkt werden nur geladene
+ * Karten: eine fehlende oder ungültige Karte wird bei der nächsten Anfrage erneut
+ * gesucht, Namen ohne Karte belegen keinen Speicher. Änderungen an einer geladenen
+ * Karte werden nicht beobachtet, sie gilt erst nach einem Neustart.
+ */
+class LevelCache {
+public:
+    LevelCache(std::string directory, RuleProfile rules);
+
+    std::shared_ptr<const Level> get(const std::string& name);
+    size_t size() const;
+
+    static bool isMapName(const std::string& name);
+
+private:
+    const std::string DIRECTORY;
+    const RuleProfile RULES;
+
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, std::shared_future<std::shared_ptr<const Level>>> levels;
+
+    std::shared_ptr<const Level> load(const std::string& name) const;
+};
+
+
+#endif //PRUEFUNG_LEVELCACHE_H
@@ -4,6 +4,13 @@
 #include <iostream>
 #include <array>
 #include <vector>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include "headers/grid.h"
+#include "headers/level.h"
+#include "headers/mapWatcher.h"
+#include "headers/threadPool.h"
 
 /**
  * @class Map
@@ -11,40 +18,78 @@
  *
  * Lädt und speichert die Karten, überprüft Karten und
  * stellt Informationen über die Umgebung zur Verfügung.
+ *
+ * Die Karten im Katalog sind die .txt-Dateien im Kartenordner und die eingebauten
+ * Karten (headers/builtinMaps.h). Eine Datei mit dem Namen einer eingebauten Karte
+ * ersetzt diese, auch wenn sie erst im laufenden Spiel angelegt wird.
  */
 class Map {
 public:
-    Map();
+    explicit Map(size_t validationThreads = 1, RuleProfile rules = RuleProfile::CLASSIC);
+    ~Map();
+
+    /// Zustand einer Karte im Katalog
+    enum class MapState { LOADING, VALID, INVALID };
 
+    bool refresh();
     bool selectMap(size_t index);
-    void renderPlayer(size_t x, size_t y) const;
+    MapState getMapState(size_t index) const;
+    std::string getMapStatus(size_t index) const;
 
-    const std::vector<std::vector<char>>& getMap() const;
+    std::shared_ptr<const Grid> getMap() const;
+    std::shared_ptr<const Level> getLevel() const;
     const std::array<size_t, 2>& getStartPos() const;
     const std::array<size_t, 2>& getGoalPos() const;
     const std::vector<std::string>& getMapsNames() const;
+    const std::string& getMapName() const;
 
 private:
+    /**
+     * @struct CatalogEntry
+     * @brief Ergebnis der Hintergrundprüfung einer Karte, geschützt durch catalogMutex.
+     */
+    struct CatalogEntry {
+        MapState state = MapState::LOADING;
+        LoadReport report;
+        std::shared_ptr<const Level> level; ///< letzte gültige Fassung, bei INVALID nur Grundlage für das Neuladen
+        std::shared_ptr<const Grid> source; ///< unbereinigte Fassung zu level, wenn sie aus der .txt-Datei kommt
+        const BuiltinMap* builtin = nullptr; ///< eingebaute Karte, solange es keine Datei mit ihrem Namen gibt
+        uint64_t version = 0; ///< Nummer des letzten Ladeauftrags, ältere Aufträge werden verworfen
+    };
+
+    static constexpr size_t NO_ENTRY = SIZE_MAX;
+
     bool mapOK;
 
-    std::vector<std::vector<char>> renderMap2D;
+    std::shared_ptr<const Level> level;
+    std::string mapName; ///< Dateiname der ausgewählten Karte
+    std::unique_ptr<ThreadPool> validationPool;
     std::vector<std::string> availableMaps;
 
+    std::vector<CatalogEntry> catalog;
+    mutable std::mutex catalogMutex;
+    std::condition_variable catalogChanged;
+    bool closing;
+    uint64_t loadVersion;
+    std::unique_ptr<MapWatcher> watcher;
+    std::unique_ptr<ThreadPool> loaderPool; ///< nach catalog, wird also vorher beendet
+
     std::array<size_t, 2> startPos, goalPos;
 
     size_t width, height;
 
-    bool isPlatformValid(size_t row, size_t col) const;
-    bool isLadderValid(size_t row, size_t col) const;
-    bool symbolCheck(size_t row, size_t col) const;
-    bool checkCurrentMap();
     bool loadMaps();
-    size_t setDimension(const std::string& input);
+    void startLoading();
+    void queueEntry(size_t index);
+    void loadEntry(const std::string& name, uint64_t version);
+    size_t findEntry(const std::string& name) const;
+    static const BuiltinMap* findBuiltin(const std::string& name);
+    void reportLoadError(const LoadReport& report) const;
+    std::string describeLoadError(const LoadReport& report) const;
 
-    void renderMap(const std::vector<std::vector<char>>& bufferMap) const;
     void addNew(const std::string& mapFileName);
 
-    const size_t MAX_SPACE, PLAYER_HEIGHT;
+    const RuleProfile RULES;
     const std::string MAP_DIRECTORY;
 };
 
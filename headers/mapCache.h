@@ -0,0 +1,31 @@
+#ifndef PRUEFUNG_MAPCACHE_H
+#define PRUEFUNG_MAPCACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "headers/level.h"
+
+/**
+ * @class MapCache
+ * @brief Liest und schreibt geprüfte Karten im Binärformat .amap.
+ *
+ * Eine .amap-Datei liegt neben der .txt-Datei und enthält die bereinigte Karte,
+ * Start- und Zielposition und die kürzeste Lösung. Sie gilt nur,
+ * solange Größe, Änderungszeit (oder, wenn nur die Zeit anders ist, der Inhaltshash)
+ * der .txt-Datei und das Regelprofil übereinstimmen.
+ */
+class MapCache {
+public:
+    static std::string cachePath(const std::string& sourcePath);
+
+    static bool load(const std::string& sourcePath, Level& level, RuleProfile rules);
+    static bool store(const std::string& sourcePath, const Level& level);
+
+    static constexpr uint64_t HASH_SEED = 14695981039346656037ull; ///< FNV-1a Startwert
+
+    static uint64_t contentHash(const char* data, size_t size, uint64_t seed = HASH_SEED);
+};
+
+
+#endif //PRUEFUNG_MAPCACHE_H
@@ -0,0 +1,44 @@
+#ifndef PRUEFUNG_MAPGENERATOR_H
+#define PRUEFUNG_MAPGENERATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+/**
+ * @struct GeneratorOptions
+ * @brief Einstellungen für MapGenerator, gleicher Seed ergibt dieselbe Karte.
+ */
+struct GeneratorOptions {
+    size_t width = 80, height = 40;
+    uint64_t seed = 1;
+    double density = 0.9;       ///< Anteil der Plattformzellen ohne Lücke, 0 bis 1
+    size_t laddersPerLayer = 2; ///< Leitern zwischen zwei Ebenen, mindestens eine
+    size_t spacing = 4;         ///< Zeilen von einer Ebene zur nächsten, 4 oder 5
+};
+
+/**
+ * @class MapGenerator
+ * @brief Erzeugt beliebig große gültige Karten, deren Ziel immer erreichbar ist.
+ *
+ * Die Karte besteht aus Ebenen im Abstand spacing, für die Regeln von ClassicRules.
+ * Zwischen spacing = MAX_SPACE + 1 und dem Sprung beim Klettern (PhysicsRules::climb())
+ * sind nur 4 und 5 möglich. Lücken in einer
+ * Ebene liegen nur über festen Zellen der nächsten Ebene, ein Fall durch eine Lücke
+ * ist also höchstens spacing Zeilen tief und überlebbar. Leitern verbinden zwei Ebenen
+ * an Spalten, die in beiden fest sind, jede Ebene hat mindestens eine. Eine Leiter
+ * nach unten beginnt nie dort, wo eine von oben ankommt, denn dort führt 'F' nach
+ * oben. S steht auf der obersten Ebene, O auf der untersten, die keine Lücken hat.
+ * Von jeder Stelle kommt man so eine Ebene tiefer (Lücke oder Leiter) und am Ende
+ * zum Ziel.
+ *
+ * Die Karte wird Zeile für Zeile geschrieben, im Speicher sind nur zwei Ebenen.
+ */
+class MapGenerator {
+public:
+    static bool write(std::ostream& out, const GeneratorOptions& options);
+    static bool optionsValid(const GeneratorOptions& options);
+};
+
+
+#endif //PRUEFUNG_MAPGENERATOR_H
@@ -0,0 +1,30 @@
+#ifndef PRUEFUNG_MAPLOADER_H
+#define PRUEFUNG_MAPLOADER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "headers/grid.h"
+
+/**
+ * @class MapLoader
+ * @brief Zerlegt den Inhalt einer Kartendatei, ohne Zwischenkopien anzulegen.
+ *
+ * Erwartet den ganzen Dateiinhalt als Speicherbereich (z.B. aus MappedFile).
+ * Zeilenenden werden mit memchr gesucht, jede Zeile wird mit einem memcpy in
+ * die Karte übernommen.
+ */
+class MapLoader {
+public:
+    enum class DimensionError { NONE, TOO_SMALL, INVALID, TOO_LARGE };
+
+    static std::string_view headerLine(const char* data, size_t size, size_t& bodyOffset);
+    static DimensionError parseDimension(std::string_view input, size_t& dimension);
+    static size_t copyRows(const char* data, size_t size, Grid& grid);
+    static size_t skipRows(const char* data, size_t size, size_t count);
+    static size_t updateRows(const char* data, size_t size, Grid& grid, std::vector<uint8_t>& dirtyBlocks);
+};
+
+
+#endif //PRUEFUNG_MAPLOADER_H
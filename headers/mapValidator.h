@@ -0,0 +1,83 @@
+#ifndef PRUEFUNG_MAPVALIDATOR_H
+#define PRUEFUNG_MAPVALIDATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "headers/grid.h"
+#include "headers/threadPool.h"
+
+/**
+ * @struct ValidationResult
+ * @brief Ergebnis einer Kartenprüfung: erster Fehler sowie Start- und Zielsymbol.
+ *
+ * Positionen sind (Zeile, Spalte) der Zelle. Bei mehreren Fehlern zählt der erste
+ * in Zeilenreihenfolge, bei mehreren S/O-Symbolen das letzte, wie beim zeilenweisen
+ * Durchlauf der ursprünglichen Prüfung.
+ */
+struct ValidationResult {
+    enum class Error { NONE, PLATFORM_ROW, PLATFORM_SPACE, LADDER_START, LADDER_END, SYMBOL_GROUND, MISSING_SYMBOL };
+
+    static constexpr size_t NO_POS = SIZE_MAX;
+
+    Error error = Error::NONE;
+    size_t errorRow = NO_POS, errorCol = NO_POS;
+    size_t conflictRow = NO_POS; ///< bei PLATFORM_SPACE: Zeile der zu nahen Plattform darunter
+
+    size_t startRow = NO_POS, startCol = NO_POS;
+    size_t goalRow = NO_POS, goalCol = NO_POS;
+
+    bool ok() const;
+    void recordError(Error kind, size_t row, size_t col, size_t conflict = NO_POS);
+    void recordStart(size_t row, size_t col);
+    void recordGoal(size_t row, size_t col);
+    void merge(const ValidationResult& other);
+};
+
+/**
+ * @class MapValidator
+ * @brief Prüft eine Karte in einem einzigen Durchlauf in O(Breite x Höhe).
+ *
+ * Alle Regeln hängen nur von einer Spalte ab. Der Validator geht die Zeilen von oben
+ * nach unten durch und merkt sich pro Spalte den Zustand (letzte Plattform, offene
+ * Leiter), statt für jede Zelle wieder nach unten zu suchen. Dabei werden Zeichen,
+ * die keine Bedeutung haben, durch Leerzeichen ersetzt. Die Zeichenklassen werden
+ * blockweise (16 Zellen) mit SSE2 bestimmt, falls verfügbar.
+ *
+ * Ein Validator bearbeitet nur die Spalten [firstCol, lastCol). firstCol muss ein
+ * Vielfaches von Grid::ALIGNMENT sein, lastCol darf bis zum STRIDE der Karte reichen.
+ * Da keine Regel über Spaltengrenzen hinweg geht, kann validate() die Karte in
+ * Spaltenbänder aufteilen und diese parallel prüfen.
+ */
+class MapValidator {
+public:
+    MapValidator(size_t first, size_t last, size_t maxSpace, size_t playerHeight);
+
+    void consumeRow(size_t row, const char* above, char* current, const char* below2);
+    ValidationResult finish();
+
+    static ValidationResult validate(Grid& grid, size_t maxSpace, size_t playerHeight, ThreadPool* pool = nullptr);
+    static ValidationResult revalidate(Grid& grid, const std::vector<uint8_t>& dirtyBlocks, size_t maxSpace,
+                                       size_t playerHeight, ThreadPool* pool = nullptr);
+
+private:
+    static constexpr size_t NONE = SIZE_MAX;
+    static constexpr size_t CHUNK = 16;
+    static constexpr size_t MIN_BAND_WIDTH = 256;
+
+    size_t firstCol, lastCol;
+    const size_t MAX_SPACE, PLAYER_HEIGHT;
+
+    std::vector<size_t> lastPlatform, pendingLadder;
+    std::vector<uint32_t> pendingPerChunk;
+
+    ValidationResult result;
+
+    void visitCell(size_t row, size_t col, char cell, const char* above, const char* below2);
+
+    static ValidationResult validateColumns(Grid& grid, size_t firstCol, size_t lastCol, size_t maxSpace,
+                                            size_t playerHeight);
+};
+
+
+#endif //PRUEFUNG_MAPVALIDATOR_H
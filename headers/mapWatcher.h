@@ -0,0 +1,40 @@
+#ifndef PRUEFUNG_MAPWATCHER_H
+#define PRUEFUNG_MAPWATCHER_H
+
+#include <string>
+#include <vector>
+
+/**
+ * @class MapWatcher
+ * @brief Meldet neue, geänderte und gelöschte Karten in einem Ordner (inotify).
+ *
+ * Es wird nicht gewartet: poll() liest nur, was seit dem letzten Aufruf passiert ist.
+ * Gemeldet werden nur .txt-Dateien, erst wenn sie fertig geschrieben oder hinein
+ * verschoben sind (IN_CLOSE_WRITE, IN_MOVED_TO), also keine halb gespeicherten Karten.
+ * Geht inotify nicht, ist isOpen() false und poll() meldet nie etwas.
+ */
+class MapWatcher {
+public:
+    /// Eine Änderung im Ordner; RESCAN, wenn Ereignisse verloren gegangen sind
+    struct Event {
+        enum class Kind { CHANGED, REMOVED, RESCAN };
+
+        Kind kind;
+        std::string name; ///< Dateiname ohne Ordner, leer bei RESCAN
+    };
+
+    explicit MapWatcher(const std::string& directory);
+    ~MapWatcher();
+
+    MapWatcher(const MapWatcher&) = delete;
+    MapWatcher& operator=(const MapWatcher&) = delete;
+
+    bool isOpen() const;
+    std::vector<Event> poll();
+
+private:
+    int fd;
+};
+
+
+#endif //PRUEFUNG_MAPWATCHER_H
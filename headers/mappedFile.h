@@ -0,0 +1,33 @@
+#ifndef PRUEFUNG_MAPPEDFILE_H
+#define PRUEFUNG_MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @class MappedFile
+ * @brief Blendet eine Datei nur lesend in den Speicher ein (mmap).
+ *
+ * Die Datei wird beim Zerstören des Objekts wieder ausgeblendet. Eine leere Datei
+ * ist gültig und hat die Größe 0.
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool isOpen() const;
+    const char* data() const;
+    size_t size() const;
+
+private:
+    bool opened;
+    const char* begin;
+    size_t length;
+};
+
+
+#endif //PRUEFUNG_MAPPEDFILE_H
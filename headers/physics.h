@@ -0,0 +1,50 @@
+#ifndef PRUEFUNG_PHYSICS_H
+#define PRUEFUNG_PHYSICS_H
+
+#include <cstddef>
+#include <cstdint>
+#include "headers/level.h"
+
+/**
+ * @struct PlayerState
+ * @brief Position und Zustand eines Spielers, unabhängig von Ausgabe und Eingabe.
+ */
+struct PlayerState {
+    size_t x = 0, y = 0;
+    bool dead = false;
+    uint32_t cell = TransitionTable::NO_CELL; ///< Zelle in Level::transitions, falls berechnet
+};
+
+/**
+ * @class Physics
+ * @brief Die Spielregeln für einen Schritt: laufen, fallen, klettern.
+ *
+ * Arbeitet nur auf einem Level und einem PlayerState, gibt nichts aus und zeichnet
+ * nichts. Wird vom Player im Spiel und von der Simulation ohne Ausgabe benutzt.
+ *
+ * step() schlägt das Ergebnis in Level::transitions nach, scan() sucht in den
+ * Bitebenen (Level::planes, nur beim Berechnen der Tabelle für hohe Karten) oder,
+ * wenn es sie nicht gibt, im Plattformindex und in der Karte.
+ * Mit ADVENTURE_CHECK_TRANSITIONS vergleicht step() jeden Zug mit scan().
+ * Die Regeln selbst stehen in PhysicsRules und gelten auch für ChunkedWorld.
+ * Welches Regelprofil gilt, steht in Level::rules; es ist schon in der Übergangstabelle
+ * enthalten, step() fragt es also nicht ab.
+ */
+class Physics {
+public:
+    /// Ergebnis eines Schritts
+    enum class Outcome { MOVED, BLOCKED, NO_LADDER, DIED, QUIT };
+
+    static PlayerState start(const Level& level);
+    static Outcome step(const Level& level, PlayerState& state, char input);
+    static Outcome scan(const Level& level, PlayerState& state, char input);
+    template <typename Rules>
+    static Outcome scanWith(const Level& level, PlayerState& state, char input);
+    static bool hasWon(const Level& level, const PlayerState& state);
+
+private:
+    static Outcome lookup(const Level& level, PlayerState& state, char input);
+};
+
+
+#endif //PRUEFUNG_PHYSICS_H
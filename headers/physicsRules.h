@@ -0,0 +1,203 @@
+#ifndef PRUEFUNG_PHYSICSRULES_H
+#define PRUEFUNG_PHYSICSRULES_H
+
+#include <cstddef>
+#include "headers/physics.h"
+#include "headers/profiler.h"
+#include "headers/ruleProfile.h"
+
+/**
+ * @class PhysicsRules
+ * @brief Die Spielregeln für einen Schritt, für jede Art von Karte.
+ *
+ * World ist ein Zugriff auf die Karte mit:
+ *   size_t width() const, size_t height() const
+ *   size_t platformAtOrBelow(size_t col, size_t row) const  erste Plattform ab row abwärts, sonst NONE
+ *   size_t platformAtOrAbove(size_t col, size_t row) const  letzte Plattform bis row aufwärts, sonst NONE
+ *   bool isLadder(size_t col, size_t row) const
+ * NONE ist PlatformIndex::NONE. So gelten dieselben Regeln für ein Level im Speicher
+ * (Physics::scan()) und für eine in Blöcken nachgeladene Karte (ChunkedWorld).
+ *
+ * Rules ist ein Regelprofil (ClassicRules, TallRules). Alle Abstände stehen damit zur
+ * Übersetzungszeit fest, die Prüfung der Körperzellen gibt es nur in Profilen mit
+ * SOLID_PLATFORMS.
+ */
+template <typename World, typename Rules = ClassicRules>
+class PhysicsRules {
+public:
+    using Outcome = Physics::Outcome;
+
+    /// zwei Plattformen einer Spalte liegen mindestens so viele Zeilen auseinander
+    static constexpr size_t LEVEL_STEP = Rules::MAX_SPACE + 1;
+
+    /**
+     * @brief Führt eine Eingabe aus, indem in der Karte gesucht wird.
+     *
+     * state.cell wird nicht verändert.
+     *
+     * @param world die Karte
+     * @param state wird aktualisiert
+     * @param input 'A' links, 'D' rechts, 'F' klettern, 'E' beenden, alles andere bewirkt nichts
+     * @return wie Physics::step()
+     */
+    static Outcome scan(const World& world, PlayerState& state, char input)
+    {
+        switch (input)
+        {
+            case 'A':
+                return move(world, state, false);
+            case 'D':
+                return move(world, state, true);
+            case 'F':
+                switch (checkLadder(world, state))
+                {
+                    case 1:
+                        return climb(world, state, true) ? Outcome::MOVED : Outcome::BLOCKED;
+                    case 2:
+                        return climb(world, state, false) ? Outcome::MOVED : Outcome::BLOCKED;
+                    default:
+                        return Outcome::NO_LADDER;
+                }
+            case 'E':
+                state.dead = true;
+                return Outcome::QUIT;
+            default:
+                return Outcome::BLOCKED;
+        }
+    }
+
+private:
+    /**
+     * @brief Bewegt den Spieler nach links oder rechts.
+     * @return MOVED, BLOCKED am Kartenrand oder DIED, wenn der Spieler zu tief fällt.
+     */
+    static Outcome move(const World& world, PlayerState& state, bool right)
+    {
+        size_t newX;
+
+        if (right)
+        {
+            newX = state.x + 1;
+            if (newX >= world.width())
+            {
+                return Outcome::BLOCKED;
+            }
+        } else if (state.x == 0)
+        {
+            return Outcome::BLOCKED;
+        } else {
+            newX = state.x - 1;
+        }
+
+        if constexpr (Rules::SOLID_PLATFORMS)
+        {
+            if (blocked(world, state.y, newX))
+            {
+                return Outcome::BLOCKED;
+            }
+        }
+
+        if (deathFall(world, state, state.y, newX))
+        {
+            state.dead = true;
+            return Outcome::DIED;
+        }
+
+        state.x = newX;
+        return Outcome::MOVED;
+    }
+
+    /**
+     * @brief Prüft, ob in der Spalte eine Plattform in einer Zeile liegt, die der Spieler belegt.
+     *
+     * Der Spieler steht auf der Plattform unter row und belegt die Zeilen
+     * row - PLAYER_HEIGHT + 1 bis row. Die unterste Plattform bis row reicht.
+     */
+    static bool blocked(const World& world, size_t row, size_t col)
+    {
+        size_t platform = world.platformAtOrAbove(col, row);
+        return platform != PlatformIndex::NONE && platform + Rules::PLAYER_HEIGHT > row;
+    }
+
+    /**
+     * @brief Prüft, ob der Spieler überlebt, falls er fällt.
+     *
+     * Überlebt der Spieler, wird seine Y-Position auf die Plattform gesetzt.
+     *
+     * @return True, wenn Player gestorben ist
+     */
+    static bool deathFall(const World& world, PlayerState& state, size_t row, size_t col)
+    {
+        size_t platform = world.platformAtOrBelow(col, row + 1); //ist jetzt was unten steht
+
+        PROFILE_COUNT("fall.lookups", 1);
+        PROFILE_COUNT("fall.rows", (platform == PlatformIndex::NONE ? world.height() : platform) - row);
+
+        //keine Plattform mehr (Karte endet) oder mehr als SAFE_FALL Felder frei
+        if (platform == PlatformIndex::NONE || platform - row - 1 > Rules::SAFE_FALL)
+        {
+            return true;
+        }
+
+        state.y = platform - 1;
+
+        return false;
+    }
+
+    /**
+     * @brief Überprüft die Leiter an der aktuellen Position des Spielers.
+     * @return 0 für keine Leiter, 1 für absteigen, 2 für aufsteigen.
+     */
+    static unsigned short checkLadder(const World& world, const PlayerState& state)
+    {
+        if (world.isLadder(state.x, state.y))
+        {
+            return 2;
+        }
+        else if (state.y + 2 < world.height() && world.isLadder(state.x, state.y + 2))
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+
+    /**
+     * @brief Bewegt den Spieler auf der Leiter nach oben oder unten.
+     *
+     * Die eigene Plattform liegt in Zeile state.y + 1, die nächste einer Spalte frühestens
+     * LEVEL_STEP Zeilen darunter bzw. darüber. Erst ab dort wird gesucht.
+     *
+     * @return True, wenn es in der Richtung eine Plattform gibt, sonst bleibt der Spieler stehen.
+     * @pre Der Spieler steht auf oder über einer Leiter (checkLadder() != 0).
+     */
+    static bool climb(const World& world, PlayerState& state, bool down)
+    {
+        size_t platform;
+
+        if (down)
+        {
+            platform = world.platformAtOrBelow(state.x, state.y + 1 + LEVEL_STEP);
+        } else if (state.y + 1 >= LEVEL_STEP)
+        {
+            platform = world.platformAtOrAbove(state.x, state.y + 1 - LEVEL_STEP);
+        } else {
+            return false;
+        }
+
+        PROFILE_COUNT("climb.lookups", 1);
+
+        if (platform == PlatformIndex::NONE)
+        {
+            return false;
+        }
+
+        PROFILE_COUNT("climb.rows", platform > state.y ? platform - state.y : state.y - platform);
+
+        state.y = platform - 1;
+        return true;
+    }
+};
+
+
+#endif //PRUEFUNG_PHYSICSRULES_H
@@ -0,0 +1,36 @@
+#ifndef PRUEFUNG_PLATFORMINDEX_H
+#define PRUEFUNG_PLATFORMINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "headers/grid.h"
+
+/**
+ * @class PlatformIndex
+ * @brief Pro Spalte die sortierten Zeilen aller Plattformen ('-').
+ *
+ * Ersetzt das zellenweise Suchen nach der nächsten Plattform über oder unter einer
+ * Position durch eine binäre Suche. Gespeichert wie eine CSR-Matrix: offsets[col]
+ * bis offsets[col + 1] sind die Einträge der Spalte col in rows.
+ */
+class PlatformIndex {
+public:
+    static constexpr size_t NONE = SIZE_MAX;
+
+    void build(const Grid& grid);
+
+    size_t firstAtOrBelow(size_t col, size_t row) const;
+    size_t lastAtOrAbove(size_t col, size_t row) const;
+
+    size_t entryOf(size_t col, size_t row) const;
+
+    const std::vector<uint32_t>& getOffsets() const;
+    const std::vector<uint32_t>& getRows() const;
+
+private:
+    std::vector<uint32_t> offsets, rows;
+};
+
+
+#endif //PRUEFUNG_PLATFORMINDEX_H
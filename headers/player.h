@@ -2,6 +2,7 @@
 #define PRUEFUNG_PLAYER_H
 
 #include "headers/map.h"
+#include "headers/physics.h"
 
 /**
  * @class Player
@@ -9,6 +10,8 @@
  *
  * Verwaltet die Position und Zustand des Spielers
  * und prüft, ob der Spieler gewonnen oder verloren hat.
+ * Die Regeln selbst stehen in Physics. Gezeichnet wird vom GameController mit einem
+ * RenderBackend, der Player meldet nur, was ein Zug bewirkt hat.
  */
 class Player {
 
@@ -16,28 +19,17 @@ public:
     Player(Map& MapObject);
 
     void reset();
-    bool updatePosition(char input);
+    Physics::Outcome updatePosition(char input);
 
     bool isDead() const;
     bool hasWon() const;
+    const PlayerState& getState() const;
 
 private:
-    enum class Direction { LEFT, RIGHT, UP, DOWN};
+    PlayerState state;
+    std::shared_ptr<const Level> level;
 
-    size_t x, y, goalX, goalY, width, height;
-    std::vector<std::vector<char>> gameMap;
-
-    bool dead;
     Map& map;
-
-    const size_t SAFE_FALL;
-
-    bool deathFall(size_t row, size_t col);
-    unsigned short checkLadder() const;
-
-    bool move(Direction direction);
-    void climb(Direction direction);
-    bool handleClimbing();
 };
 
 
@@ -0,0 +1,90 @@
+#ifndef PRUEFUNG_PROFILER_H
+#define PRUEFUNG_PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+/**
+ * @class Profiler
+ * @brief Zeitmessung und Zähler für die heißen Pfade, nur mit -DADVENTURE_PROFILE.
+ *
+ * PROFILE_SCOPE("name") misst die Zeit bis zum Ende des Blocks, PROFILE_COUNT("name", n)
+ * zählt n dazu. Jede Stelle legt beim ersten Durchlauf ein statisches Site- bzw.
+ * Counter-Objekt an und zählt danach nur noch mit relaxed-Atomics, also ohne Sperre.
+ * Nur wenn eine Trace-Datei geschrieben wird, wird jede Messung zusätzlich als
+ * Ereignis gespeichert (mit Sperre).
+ *
+ * Ohne ADVENTURE_PROFILE sind die Makros leer, es bleibt kein Code in den heißen
+ * Pfaden. Die Klasse selbst gibt es trotzdem, sie hat dann nur keine Messwerte.
+ *
+ * Ausgabe: hudLine() für eine Zeile unter dem Spiel, printSummary() beim Beenden
+ * und writeTrace() als Chrome trace_event JSON (chrome://tracing, Perfetto).
+ */
+class Profiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+#if defined(ADVENTURE_PROFILE)
+    static constexpr bool COMPILED = true;
+#else
+    static constexpr bool COMPILED = false;
+#endif
+
+    /// Eine gemessene Stelle: Anzahl, Summe, Maximum und letzte Dauer in Nanosekunden
+    struct Site {
+        explicit Site(const char* label);
+
+        const char* name;
+        std::atomic<uint64_t> calls{0}, totalNs{0}, maxNs{0}, lastNs{0};
+        Site* next;
+    };
+
+    /// Ein Zähler, z.B. geschriebene Bytes
+    struct Counter {
+        explicit Counter(const char* label);
+
+        const char* name;
+        std::atomic<uint64_t> value{0};
+        Counter* next;
+
+        void add(uint64_t amount) { value.fetch_add(amount, std::memory_order_relaxed); }
+    };
+
+    /// Misst die Zeit von der Konstruktion bis zur Zerstörung
+    class Scope {
+    public:
+        explicit Scope(Site& measured) : site(measured), start(Clock::now()) {}
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        Site& site;
+        Clock::time_point start;
+    };
+
+    static void enableTrace();
+    static bool writeTrace(const std::string& path);
+    static void printSummary(std::ostream& out);
+    static std::string hudLine();
+};
+
+#if defined(ADVENTURE_PROFILE)
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) \
+    static Profiler::Site PROFILE_CONCAT(profileSite, __LINE__)(name); \
+    Profiler::Scope PROFILE_CONCAT(profileScope, __LINE__)(PROFILE_CONCAT(profileSite, __LINE__))
+#define PROFILE_COUNT(name, amount) \
+    do { static Profiler::Counter profileCounter(name); profileCounter.add(amount); } while (false)
+#else
+#define PROFILE_SCOPE(name) static_cast<void>(0)
+#define PROFILE_COUNT(name, amount) static_cast<void>(0)
+#endif
+
+
+#endif //PRUEFUNG_PROFILER_H
@@ -0,0 +1,53 @@
+#ifndef PRUEFUNG_REACHABILITY_H
+#define PRUEFUNG_REACHABILITY_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "headers/level.h"
+#include "headers/threadPool.h"
+
+/**
+ * @struct Solution
+ * @brief Ergebnis der Erreichbarkeitsprüfung.
+ */
+struct Solution {
+    bool reachable = false;
+    std::string inputs;       ///< kürzeste Eingabefolge vom Start zum Ziel, z.B. "DDDFD"
+    size_t visitedStates = 0; ///< Anzahl der erreichbaren Positionen, die angeschaut wurden
+};
+
+/**
+ * @class Reachability
+ * @brief Breitensuche über alle Positionen, an denen der Spieler stehen kann.
+ *
+ * Der Spieler steht immer direkt über einer Plattform. Jede Plattformzelle ist also
+ * ein Zustand, seine Nummer ist der Eintrag im PlatformIndex. Die Übergänge für
+ * 'A', 'D' und 'F' stehen in Level::transitions und sind genau die Regeln aus
+ * Physics, mit Fallen, Tod bei zu tiefem Fall und Leitersprüngen. Besuchte Zustände
+ * stehen in einem Bitfeld.
+ *
+ * Mit einem ThreadPool werden die Nachfolger einer Ebene (Frontier) parallel
+ * berechnet und danach in fester Reihenfolge eingetragen. Das Ergebnis ist daher
+ * dasselbe wie ohne Threads.
+ */
+class Reachability {
+public:
+    static Solution solve(const Level& level, ThreadPool* pool = nullptr);
+
+private:
+    static constexpr char INPUTS[TransitionTable::INPUTS] = {'A', 'D', 'F'};
+    static constexpr size_t MIN_PARALLEL = 4096; ///< kleinere Ebenen bearbeitet der aufrufende Thread
+
+    /// gefundener Nachfolger: Zustand und wie er erreicht wurde
+    struct Edge {
+        uint32_t target, source;
+        uint8_t input;
+    };
+
+    static void expand(const Level& level, const std::vector<uint32_t>& frontier, size_t first, size_t last,
+                       const std::vector<uint64_t>& visited, std::vector<Edge>& edges);
+};
+
+
+#endif //PRUEFUNG_REACHABILITY_H
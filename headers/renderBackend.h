@@ -0,0 +1,94 @@
+#ifndef PRUEFUNG_RENDERBACKEND_H
+#define PRUEFUNG_RENDERBACKEND_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include "headers/grid.h"
+
+/// Ausgabe für die Bilder, beim Start gewählt (--render, --capture)
+enum class RenderSink { TERMINAL, NONE, CAPTURE };
+
+/**
+ * @class RenderBackend
+ * @brief Empfängt die Bilder und Meldungen des Spiels und gibt sie irgendwo aus.
+ *
+ * Das Spiel meldet nur Ereignisse: ein Bild (Karte und Position des Spielers) nach
+ * jedem Zug, der etwas geändert hat, und Meldungen wie "kein Leiter". Welche Zellen
+ * sich gegenüber dem letzten Bild geändert haben, bestimmt die Ausgabe selbst, sie
+ * weiß, was sie zuletzt gezeigt hat.
+ *
+ * Ausgaben: Renderer (Terminal), CaptureRenderer (asciicast-Datei) und NullRenderer
+ * (nichts, für Messungen und Läufe ohne Terminal).
+ */
+class RenderBackend {
+public:
+    virtual ~RenderBackend() = default;
+
+    /**
+     * @brief Ein Bild: die Karte mit dem Spieler.
+     * @param grid Schnappschuss der Karte, derselbe Zeiger heißt dieselbe Karte
+     */
+    virtual void drawFrame(const std::shared_ptr<const Grid>& grid, size_t playerX, size_t playerY) = 0;
+
+    /// eine Meldung an den Spieler, eine Zeile ohne '\n'
+    virtual void message(const std::string& line) = 0;
+
+    /// das nächste Bild ganz zeichnen, nicht nur die Änderungen
+    virtual void invalidate() = 0;
+
+    /// Zeilen des Spielers, von seiner Position nach oben
+    virtual void setPlayerHeight(size_t rows) = 0;
+
+    /// Zeile unter jedem Bild, leer für keine
+    virtual void setFooter(const std::string& line) = 0;
+
+    /// Eingabeaufforderung für den Zeilenmodus, leer für keine; darunter tippt der Spieler seinen Zug
+    virtual void setPrompt(const std::string& line) = 0;
+
+    /// zeigt die Eingabeaufforderung vor dem Lesen eines Zuges
+    virtual void prompt() = 0;
+
+    ///@brief Anzahl Bytes des letzten Bildes
+    size_t getLastFrameBytes() const { return lastFrameBytes; }
+
+    ///@brief Anzahl Bytes aller bisherigen Bilder
+    size_t getTotalBytes() const { return totalBytes; }
+
+    ///@brief Anzahl der bisher gezeichneten Bilder
+    size_t getFrameCount() const { return frameCount; }
+
+protected:
+    RenderBackend() = default;
+
+    ///@brief Zählt ein ausgegebenes Bild mit so vielen Bytes
+    void countFrame(size_t bytes)
+    {
+        lastFrameBytes = bytes;
+        totalBytes += bytes;
+        ++frameCount;
+    }
+
+private:
+    size_t lastFrameBytes = 0, totalBytes = 0, frameCount = 0;
+};
+
+/**
+ * @class NullRenderer
+ * @brief Gibt nichts aus, zählt nur die Bilder.
+ *
+ * Für Läufe ohne Terminal und für Messungen, die nur die Spielregeln kosten sollen.
+ */
+class NullRenderer final : public RenderBackend {
+public:
+    void drawFrame(const std::shared_ptr<const Grid>&, size_t, size_t) override { countFrame(0); }
+    void message(const std::string&) override {}
+    void invalidate() override {}
+    void setPlayerHeight(size_t) override {}
+    void setFooter(const std::string&) override {}
+    void setPrompt(const std::string&) override {}
+    void prompt() override {}
+};
+
+
+#endif //PRUEFUNG_RENDERBACKEND_H
@@ -0,0 +1,96 @@
+#ifndef PRUEFUNG_RENDERER_H
+#define PRUEFUNG_RENDERER_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "headers/grid.h"
+#include "headers/renderBackend.h"
+
+/**
+ * @class Renderer
+ * @brief Zeichnet die Karte mit dem Spieler ins Terminal (RenderSink::TERMINAL).
+ *
+ * Merkt sich das zuletzt gezeichnete Bild (Karte und Spielerposition). Ist die Karte
+ * gleich geblieben, werden per ANSI-Cursorsteuerung nur die geänderten Zellen
+ * neu gezeichnet. Jedes Bild wird in einem Puffer zusammengebaut und mit einem
+ * einzigen write(2) ausgegeben.
+ *
+ * Im Modus CAMERA wird im Terminal nur ein Ausschnitt in Terminalgröße gezeichnet,
+ * der dem Spieler folgt. Ein Bild kostet dann O(Ausschnitt) statt O(Breite x Höhe).
+ * Der Ausschnitt verschiebt sich erst, wenn der Spieler näher als deadZone Zellen
+ * an seinen Rand kommt. Passt die ganze Karte ins Terminal, ist der Ausschnitt die
+ * ganze Karte. Ohne Terminal wird immer die ganze Karte ausgegeben.
+ *
+ * Eine Fußzeile (z.B. die Steuerung) wird mit jedem ganzen Bild gezeichnet und
+ * bleibt bei den Änderungsbildern stehen. Darunter folgen MESSAGE_ROWS Zeilen für
+ * Meldungen und im Zeilenmodus die Eingabeaufforderung, gefolgt von der Eingabe des
+ * Spielers und der Zeile, auf der der Cursor nach Enter landet. Alle diese Zeilen
+ * werden beim Ausschnitt und bei der Frage, ob die Karte ins Terminal passt,
+ * abgezogen (reservedRows()). Sonst scrollt das Terminal, und die Cursorpositionen
+ * der Änderungsbilder treffen falsche Zeilen.
+ *
+ * Abgeleitete Klassen können statt des Terminals ein Terminal fester Größe annehmen
+ * und die fertigen Bilder selbst ausgeben (output()), siehe CaptureRenderer.
+ */
+class Renderer : public RenderBackend {
+public:
+    /// CAMERA: Ausschnitt um den Spieler, FULL: immer die ganze Karte
+    enum class Mode { CAMERA, FULL };
+
+    static constexpr size_t AUTO_DEAD_ZONE = SIZE_MAX; ///< ein Viertel des Ausschnitts
+    static constexpr size_t MESSAGE_ROWS = 2; ///< z.B. "kein Leiter" und die HUD-Zeile
+    static constexpr size_t PROMPT_ROWS = 3; ///< Aufforderung, Eingabe, Zeile nach Enter
+
+    explicit Renderer(int fileDescriptor);
+
+    void drawFrame(const std::shared_ptr<const Grid>& grid, size_t playerX, size_t playerY) override;
+    void message(const std::string& line) override;
+    void invalidate() override;
+
+    void setMode(Mode newMode);
+    void setDeadZone(size_t cells);
+    void setPlayerHeight(size_t rows) override;
+    void setFooter(const std::string& line) override;
+    void setPrompt(const std::string& line) override;
+    void prompt() override;
+
+protected:
+    Renderer(unsigned short rows, unsigned short cols);
+
+    virtual void output(const std::string& bytes);
+
+private:
+    int fd;
+    bool ansi;
+    bool fixedSize; ///< Terminal mit fester Größe termRows x termCols statt ioctl(fd)
+
+    Mode mode;
+    size_t deadZone;
+    size_t playerHeight; ///< Zeilen des Spielers, von seiner Position nach oben
+    size_t viewTop, viewLeft, viewRows, viewCols; ///< Ausschnitt der Karte im Modus CAMERA
+
+    std::shared_ptr<const Grid> shownMap;
+    size_t shownX, shownY;
+    unsigned short termRows, termCols;
+
+    std::string frame;
+    std::string footer; ///< Zeile, die unter jedem Bild stehen bleibt, leer = keine
+    std::string promptLine; ///< Eingabeaufforderung unter der Fußzeile, leer = keine
+    bool anchored; ///< das letzte Bild steht oben im Terminal, Zeilen darunter sind per Cursor erreichbar
+    size_t messageCount; ///< Meldungen seit dem letzten Bild bzw. der letzten Eingabeaufforderung
+
+    bool terminalChanged();
+    size_t reservedRows() const;
+    bool fitsTerminal(const Grid& grid) const;
+    bool follow(const Grid& grid, size_t playerX, size_t playerY, bool recenter);
+    void composeFull(const Grid& grid, size_t playerX, size_t playerY);
+    void composeView(const Grid& grid, size_t playerX, size_t playerY);
+    void composeDiff(const Grid& grid, size_t playerX, size_t playerY);
+    bool isPlayerRow(size_t row, size_t playerY) const;
+    void appendFooter();
+    void flush();
+};
+
+
+#endif //PRUEFUNG_RENDERER_H
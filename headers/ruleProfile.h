@@ -0,0 +1,109 @@
+#ifndef PRUEFUNG_RULEPROFILE_H
+#define PRUEFUNG_RULEPROFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// Auswahl der Spielregeln zur Laufzeit, z.B. mit --rules; steht im Level und in den Dateiköpfen
+enum class RuleProfile : uint8_t { CLASSIC, TALL };
+
+/**
+ * @struct ClassicRules
+ * @brief Die Regeln des ursprünglichen Spiels: der Spieler ist ein einzelnes Feld.
+ *
+ * Ein Regelprofil steht ganz zur Übersetzungszeit fest. PhysicsRules und die
+ * Übergangstabelle werden für jedes Profil einzeln übersetzt, im Zug gibt es also
+ * keine Abfrage des Profils.
+ *
+ * Eine Plattform auf Höhe des Spielers hält ihn hier nicht auf, er läuft hindurch
+ * und fällt oder steigt danach wie sonst auch.
+ */
+struct ClassicRules {
+    static constexpr RuleProfile PROFILE = RuleProfile::CLASSIC;
+    static constexpr size_t PLAYER_HEIGHT = 1;         ///< Zeilen über der Plattform, die der Spieler belegt
+    static constexpr size_t MAX_SPACE = 3;             ///< zwei Plattformen einer Spalte liegen mehr als MAX_SPACE Zeilen auseinander
+    static constexpr size_t SAFE_FALL = 5;             ///< so viele freie Zeilen übersteht ein Fall
+    static constexpr bool SOLID_PLATFORMS = false;     ///< Plattformen auf Körperhöhe halten den Spieler auf
+};
+
+/**
+ * @struct TallRules
+ * @brief Der Spieler ist drei Zeilen hoch, wie im Muster der Aufgabe.
+ *
+ * Beim Laufen muss in der Zielspalte jede Zeile frei sein, die der Spieler belegt,
+ * sonst bleibt er stehen. Beim Klettern und Fallen ist das durch die Prüfung der
+ * Karte sicher: zwischen zwei Plattformen einer Spalte sind mindestens MAX_SPACE
+ * Zeilen frei und über der obersten mindestens PLAYER_HEIGHT.
+ */
+struct TallRules {
+    static constexpr RuleProfile PROFILE = RuleProfile::TALL;
+    static constexpr size_t PLAYER_HEIGHT = 3;
+    static constexpr size_t MAX_SPACE = 3;
+    static constexpr size_t SAFE_FALL = 5;
+    static constexpr bool SOLID_PLATFORMS = true;
+
+    static_assert(MAX_SPACE >= PLAYER_HEIGHT, "der Spieler muss zwischen zwei Plattformen passen");
+};
+
+/// Kennwerte eines Profils für Code, der das Profil erst zur Laufzeit kennt (Prüfung, Zeichnen)
+struct RuleLimits {
+    size_t maxSpace, playerHeight;
+};
+
+template <typename Rules>
+constexpr RuleLimits limitsOf()
+{
+    return {Rules::MAX_SPACE, Rules::PLAYER_HEIGHT};
+}
+
+/**
+ * @brief Ruft function einmal mit dem Profil als Typ auf (ClassicRules{} bzw. TallRules{}).
+ *
+ * So wird am Anfang einer Arbeit (Tabelle berechnen, Folge abspielen) einmal
+ * verzweigt und darin nur noch der für das Profil übersetzte Code ausgeführt.
+ */
+template <typename Function>
+decltype(auto) withRules(RuleProfile profile, Function&& function)
+{
+    switch (profile)
+    {
+        case RuleProfile::TALL:
+            return function(TallRules{});
+        case RuleProfile::CLASSIC:
+            break;
+    }
+    return function(ClassicRules{});
+}
+
+///@brief Kennwerte zu einem Profil
+inline RuleLimits limitsOf(RuleProfile profile)
+{
+    return withRules(profile, [](auto rules) { return limitsOf<decltype(rules)>(); });
+}
+
+///@brief Name für Optionen und Ausgaben: "classic" oder "tall"
+inline const char* ruleProfileName(RuleProfile profile)
+{
+    return profile == RuleProfile::TALL ? "tall" : "classic";
+}
+
+/**
+ * @brief Profil zu einem Namen wie bei ruleProfileName().
+ * @return False, wenn es den Namen nicht gibt
+ */
+inline bool parseRuleProfile(const std::string& name, RuleProfile& profile)
+{
+    for (RuleProfile candidate : {RuleProfile::CLASSIC, RuleProfile::TALL})
+    {
+        if (name == ruleProfileName(candidate))
+        {
+            profile = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+
+#endif //PRUEFUNG_RULEPROFILE_H
@@ -0,0 +1,32 @@
+#ifndef PRUEFUNG_SIMULATION_H
+#define PRUEFUNG_SIMULATION_H
+
+#include <string_view>
+#include "headers/level.h"
+#include "headers/physics.h"
+
+/**
+ * @struct SimulationResult
+ * @brief Endzustand nach dem Abspielen einer Eingabefolge.
+ */
+struct SimulationResult {
+    bool won = false, dead = false;
+    size_t x = 0, y = 0; ///< letzte Position
+    size_t steps = 0;    ///< verarbeitete Eingaben, wie viele Züge im Spiel
+};
+
+/**
+ * @class Simulation
+ * @brief Spielt Eingabefolgen ohne Ausgabe ab, z.B. für Regressionstests von Karten.
+ *
+ * Es gelten dieselben Regeln wie bei Player::updatePosition(), es wird aber nichts
+ * gezeichnet und nichts ausgegeben. Wie im Spiel zählt jedes Zeichen außer Leerraum
+ * als ein Zug, das Spiel endet beim Erreichen des Ziels, beim Tod oder mit 'E'.
+ */
+class Simulation {
+public:
+    static SimulationResult run(const Level& level, std::string_view inputs);
+};
+
+
+#endif //PRUEFUNG_SIMULATION_H
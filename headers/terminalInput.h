@@ -0,0 +1,39 @@
+#ifndef PRUEFUNG_TERMINALINPUT_H
+#define PRUEFUNG_TERMINALINPUT_H
+
+#include <chrono>
+#include <cstddef>
+#include <termios.h>
+
+/**
+ * @class TerminalInput
+ * @brief Schaltet die Standardeingabe in den Rohmodus und liest Tasten ohne zu blockieren.
+ *
+ * Im Rohmodus (nicht kanonisch, ohne Echo) kommt jede Taste sofort an, ohne Enter.
+ * Strg+C löst kein Signal aus, sondern wird als Taste gelesen, damit das Terminal
+ * immer im Destruktor wiederhergestellt wird. Ist die Eingabe kein Terminal
+ * (Pipe, Datei), bleibt sie unverändert und isRaw() ist false.
+ */
+class TerminalInput {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr char INTERRUPT = '\x03'; ///< Strg+C im Rohmodus
+
+    TerminalInput();
+    ~TerminalInput();
+
+    TerminalInput(const TerminalInput&) = delete;
+    TerminalInput& operator=(const TerminalInput&) = delete;
+
+    bool isRaw() const;
+    bool waitUntil(Clock::time_point deadline) const;
+    size_t read(char* buffer, size_t size) const;
+
+private:
+    bool raw;
+    termios saved;
+};
+
+
+#endif //PRUEFUNG_TERMINALINPUT_H
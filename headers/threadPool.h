@@ -0,0 +1,45 @@
+#ifndef PRUEFUNG_THREADPOOL_H
+#define PRUEFUNG_THREADPOOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ThreadPool
+ * @brief Feste Anzahl von Arbeitsthreads, die Aufgaben aus einer Warteschlange abarbeiten.
+ */
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(std::function<void()> task);
+    void wait();
+    void parallelFor(size_t count, const std::function<void(size_t)>& job);
+
+    size_t size() const;
+
+    static size_t hardwareThreads();
+
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+
+    std::mutex mutex;
+    std::condition_variable taskReady, allDone;
+
+    size_t running;
+    bool stopping;
+
+    void workerLoop();
+};
+
+
+#endif //PRUEFUNG_THREADPOOL_H
@@ -0,0 +1,86 @@
+#ifndef PRUEFUNG_TILEPLANES_H
+#define PRUEFUNG_TILEPLANES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "headers/grid.h"
+
+/**
+ * @class TilePlanes
+ * @brief Plattformen ('-') und Leitern ('H') der bereinigten Karte als Bitebenen.
+ *
+ * Die Ebenen sind spaltenweise in 64-Bit-Wörtern gespeichert: Bit (row % 64) von Wort
+ * col * wordsPerColumn + row / 64. Eine Zelle kostet so 2 Bit zusätzlich zur Karte.
+ *
+ * Die nächste Plattform unter oder über einer Position ist damit ein count trailing
+ * bzw. leading zeros über meist ein einziges Wort, eine Leiter ist ein Bittest.
+ * Das lohnt sich erst bei hohen Karten (paysOff()), wo die binäre Suche im
+ * Plattformindex viele Einträge pro Spalte hat. Gebraucht werden die Ebenen nur,
+ * während die Übergangstabelle berechnet wird, siehe Level::buildTransitions().
+ */
+class TilePlanes {
+public:
+    static constexpr size_t NONE = SIZE_MAX;
+    static constexpr size_t MIN_HEIGHT = 512; ///< ab so vielen Zeilen sind die Ebenen schneller als der Plattformindex
+
+    static bool paysOff(const Grid& grid);
+
+    void build(const Grid& grid);
+    void clear();
+
+    bool empty() const;
+    size_t memoryBytes() const;
+
+    bool isPlatform(size_t col, size_t row) const { return test(platforms, col, row); }
+    bool isLadder(size_t col, size_t row) const { return test(ladders, col, row); }
+
+    /// erste Plattform in Spalte col in Zeile row oder darunter, NONE wenn keine
+    size_t platformAtOrBelow(size_t col, size_t row) const
+    {
+        if (row >= height) return NONE;
+
+        const uint64_t* column = &platforms[col * wordsPerColumn];
+        size_t word = row / 64;
+        uint64_t bits = column[word] & (~uint64_t{0} << (row % 64));
+
+        while (bits == 0)
+        {
+            if (++word == wordsPerColumn) return NONE;
+            bits = column[word];
+        }
+
+        return word * 64 + static_cast<size_t>(__builtin_ctzll(bits));
+    }
+
+    /// letzte Plattform in Spalte col in Zeile row oder darüber, NONE wenn keine
+    size_t platformAtOrAbove(size_t col, size_t row) const
+    {
+        if (height == 0) return NONE;
+        if (row >= height) row = height - 1;
+
+        const uint64_t* column = &platforms[col * wordsPerColumn];
+        size_t word = row / 64;
+        uint64_t bits = column[word] & (~uint64_t{0} >> (63 - row % 64));
+
+        while (bits == 0)
+        {
+            if (word-- == 0) return NONE;
+            bits = column[word];
+        }
+
+        return word * 64 + 63 - static_cast<size_t>(__builtin_clzll(bits));
+    }
+
+private:
+    size_t height = 0, width = 0, wordsPerColumn = 0;
+    std::vector<uint64_t> platforms, ladders;
+
+    bool test(const std::vector<uint64_t>& plane, size_t col, size_t row) const
+    {
+        return row < height && (plane[col * wordsPerColumn + row / 64] >> (row % 64) & 1) != 0;
+    }
+};
+
+
+#endif //PRUEFUNG_TILEPLANES_H
@@ -0,0 +1,71 @@
+#ifndef PRUEFUNG_TRANSITIONTABLE_H
+#define PRUEFUNG_TRANSITIONTABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "headers/threadPool.h"
+
+struct Level;
+
+/**
+ * @class TransitionTable
+ * @brief Vorberechnetes Ergebnis jeder Eingabe an jeder Position, ein Zug ist ein Nachschlagen.
+ *
+ * Der Spieler steht immer direkt über einer Plattform, jede Plattformzelle ist also eine
+ * Position (Zelle). Ihre Nummer ist ihr Eintrag im PlatformIndex. Für jede Zelle und
+ * jede der Eingaben 'A', 'D', 'F' steht in der Tabelle die Nummer der nächsten Zelle
+ * oder einer der Codes DEAD, STAY und NO_LADDER. Die Tabelle wird beim Laden mit den
+ * Regeln aus Physics berechnet, es gibt nur Einträge für Plattformzellen. Das Regelprofil
+ * (Level::rules) wird dabei einmal ausgewählt, nicht für jede Zelle.
+ *
+ * Ein Zug hängt nur von der eigenen und den beiden Nachbarspalten ab. Nach einer
+ * Änderung der Karte berechnet update() deshalb nur die Spalten neben geänderten
+ * Blöcken neu und übernimmt alle anderen Einträge aus der vorherigen Tabelle.
+ */
+class TransitionTable {
+public:
+    static constexpr uint32_t DEAD = UINT32_MAX;          ///< zu tief gefallen
+    static constexpr uint32_t STAY = UINT32_MAX - 1;      ///< Kartenrand oder keine Plattform beim Klettern
+    static constexpr uint32_t NO_LADDER = UINT32_MAX - 2; ///< 'F' ohne Leiter
+    static constexpr uint32_t NO_CELL = UINT32_MAX - 3;   ///< keine Zelle, z.B. vor build()
+    static constexpr size_t INPUTS = 3;
+
+    void build(const Level& level, ThreadPool* pool = nullptr);
+    void update(const Level& level, const Level& previous, const std::vector<uint8_t>& dirtyBlocks,
+                ThreadPool* pool = nullptr);
+
+    bool empty() const;
+    size_t size() const;
+
+    /// Spalte 0 für 'A', 1 für 'D', 2 für 'F', INPUTS für alle anderen Eingaben
+    static size_t slot(char input)
+    {
+        return input == 'A' ? 0 : (input == 'D' ? 1 : (input == 'F' ? 2 : INPUTS));
+    }
+
+    /// nächste Zelle oder DEAD, STAY, NO_LADDER
+    uint32_t next(uint32_t cell, size_t inputSlot) const
+    {
+        return targets[cell * INPUTS + inputSlot];
+    }
+
+    /// Spalte, in der der Spieler auf der Zelle steht
+    uint32_t column(uint32_t cell) const
+    {
+        return columns[cell];
+    }
+
+private:
+    static constexpr size_t MIN_PARALLEL = 65536; ///< kleinere Karten berechnet der aufrufende Thread
+
+    std::vector<uint32_t> targets; ///< INPUTS Einträge pro Zelle
+    std::vector<uint32_t> columns;
+
+    template <typename Rules>
+    void scanColumn(const Level& level, size_t col);
+    void copyColumn(const Level& level, const Level& previous, size_t col);
+};
+
+
+#endif //PRUEFUNG_TRANSITIONTABLE_H
@@ -0,0 +1,237 @@
+#include "headers/inputLog.h"
+#include "headers/mapCache.h"
+#include "headers/mappedFile.h"
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+const char MAGIC[4] = {'A', 'L', 'O', 'G'};
+const uint8_t VERSION = 2;
+
+const uint8_t WON = 1, DEAD = 2;
+
+///@brief Hängt value als LEB128 an (7 Bit pro Byte, höchstes Bit = es folgt noch ein Byte)
+void putNumber(std::string& out, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+/**
+ * @class Reader
+ * @brief Liest die Felder einer .alog-Datei nacheinander, merkt sich Lesefehler.
+ */
+class Reader {
+public:
+    Reader(const char* data, size_t size) : position(data), end(data + size), failed(false) {}
+
+    uint8_t byte()
+    {
+        if (position == end)
+        {
+            failed = true;
+            return 0;
+        }
+        return static_cast<uint8_t>(*position++);
+    }
+
+    uint64_t number()
+    {
+        uint64_t value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7)
+        {
+            uint8_t part = byte();
+            value |= static_cast<uint64_t>(part & 0x7F) << shift;
+            if ((part & 0x80) == 0) return value;
+        }
+        failed = true;
+        return 0;
+    }
+
+    bool bytes(void* target, size_t count)
+    {
+        if (static_cast<size_t>(end - position) < count)
+        {
+            failed = true;
+            return false;
+        }
+        std::memcpy(target, position, count);
+        position += count;
+        return true;
+    }
+
+    bool ok() const { return !failed; }
+    bool atEnd() const { return position == end; }
+
+private:
+    const char* position;
+    const char* end;
+    bool failed;
+};
+
+}
+
+/**
+ * @brief Zeichnet eine Eingabe auf.
+ *
+ * Ist sie gleich der vorherigen, wird nur die letzte Folge verlängert.
+ *
+ * @param input Eingabe, wie sie an Player::updatePosition() ging
+ * @param timeMs Zeit seit Spielbeginn, nicht kleiner als bei der vorherigen Eingabe
+ */
+void InputLog::record(char input, uint32_t timeMs)
+{
+    if (!runs.empty() && runs.back().input == input)
+    {
+        InputRun& run = runs.back();
+        ++run.count;
+        run.durationMs = timeMs - run.startMs;
+        return;
+    }
+
+    InputRun run;
+    run.input = input;
+    run.count = 1;
+    run.startMs = timeMs;
+    runs.push_back(run);
+}
+
+///@brief Alle Eingaben hintereinander, wie für Simulation::run()
+std::string InputLog::inputs() const
+{
+    std::string all;
+    for (const InputRun& run : runs)
+    {
+        all.append(run.count, run.input);
+    }
+    return all;
+}
+
+/**
+ * @brief Schreibt die Aufzeichnung als .alog-Datei.
+ * @return False, wenn die Datei nicht geschrieben werden konnte
+ */
+bool InputLog::write(const std::string& path) const
+{
+    std::string out(MAGIC, sizeof(MAGIC));
+    out.push_back(static_cast<char>(VERSION));
+    out.push_back(static_cast<char>(rules));
+
+    for (unsigned shift = 0; shift < 64; shift += 8)
+    {
+        out.push_back(static_cast<char>((mapHash >> shift) & 0xFF));
+    }
+
+    putNumber(out, mapName.size());
+    out.append(mapName);
+
+    putNumber(out, startX);
+    putNumber(out, startY);
+
+    out.push_back(static_cast<char>((end.won ? WON : 0) | (end.dead ? DEAD : 0)));
+    putNumber(out, end.x);
+    putNumber(out, end.y);
+    putNumber(out, end.steps);
+
+    putNumber(out, runs.size());
+    uint32_t previousStart = 0;
+    for (const InputRun& run : runs)
+    {
+        out.push_back(run.input);
+        putNumber(out, run.count);
+        putNumber(out, run.startMs - previousStart);
+        putNumber(out, run.durationMs);
+        previousStart = run.startMs;
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(out.data(), static_cast<std::streamsize>(out.size()));
+    return static_cast<bool>(file);
+}
+
+/**
+ * @brief Liest eine .alog-Datei.
+ * @param log wird gefüllt
+ * @return False, wenn die Datei fehlt, eine andere Version hat oder beschädigt ist
+ */
+bool InputLog::read(const std::string& path, InputLog& log)
+{
+    MappedFile file(path);
+    if (!file.isOpen()) return false;
+
+    Reader reader(file.data(), file.size());
+
+    char magic[sizeof(MAGIC)];
+    if (!reader.bytes(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0
+        || reader.byte() != VERSION)
+    {
+        return false;
+    }
+
+    log = InputLog();
+
+    uint8_t profile = reader.byte();
+    if (profile > static_cast<uint8_t>(RuleProfile::TALL)) return false;
+    log.rules = static_cast<RuleProfile>(profile);
+
+    for (unsigned shift = 0; shift < 64; shift += 8)
+    {
+        log.mapHash |= static_cast<uint64_t>(reader.byte()) << shift;
+    }
+
+    size_t nameLength = reader.number();
+    if (nameLength > file.size()) return false;
+    log.mapName.resize(nameLength);
+    reader.bytes(&log.mapName[0], nameLength);
+
+    log.startX = reader.number();
+    log.startY = reader.number();
+
+    uint8_t state = reader.byte();
+    log.end.won = (state & WON) != 0;
+    log.end.dead = (state & DEAD) != 0;
+    log.end.x = reader.number();
+    log.end.y = reader.number();
+    log.end.steps = reader.number();
+
+    size_t runCount = reader.number();
+    if (runCount > file.size()) return false; //jede Folge braucht mindestens ein Byte
+
+    uint32_t start = 0;
+    log.runs.resize(runCount);
+    for (InputRun& run : log.runs)
+    {
+        run.input = static_cast<char>(reader.byte());
+        run.count = static_cast<uint32_t>(reader.number());
+        start += static_cast<uint32_t>(reader.number());
+        run.startMs = start;
+        run.durationMs = static_cast<uint32_t>(reader.number());
+    }
+
+    return reader.ok() && reader.atEnd();
+}
+
+/**
+ * @brief Hash über die geprüfte Karte: Größe und alle Zellen.
+ *
+ * Die bereinigte Karte ist gleich, egal ob sie aus der .txt- oder der .amap-Datei
+ * geladen wurde, der Hash also auch.
+ */
+uint64_t InputLog::hashLevel(const Level& level)
+{
+    const Grid& grid = level.grid;
+    uint64_t size[2] = {grid.getHeight(), grid.getWidth()};
+
+    uint64_t hash = MapCache::contentHash(reinterpret_cast<const char*>(size), sizeof(size));
+    for (size_t row = 0; row < grid.getHeight(); ++row)
+    {
+        hash = MapCache::contentHash(grid.row(row), grid.getWidth(), hash);
+    }
+
+    return hash;
+}
@@ -0,0 +1,286 @@
+#include "headers/level.h"
+#include "headers/mappedFile.h"
+#include "headers/reachability.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+/**
+ * @brief Öffnet die Datei und liest Höhe und Breite aus der ersten Zeile.
+ *
+ * Hat die Karte mehr als Level::MAX_CELLS Zellen, gilt die Breite als zu groß, bevor
+ * irgendetwas dafür angelegt wird. Kleinere Karten, für die der Speicher nicht reicht,
+ * meldet der Aufrufer (Map::loadEntry()) als OUT_OF_MEMORY.
+ *
+ * @return False, wenn das nicht geht; der Grund steht dann in report
+ */
+bool readHeader(const MappedFile& file, LoadReport& report, size_t& bodyOffset, size_t& height, size_t& width)
+{
+    if (!file.isOpen())
+    {
+        report.status = LoadReport::Status::OPEN_FAILED;
+        return false;
+    }
+
+    std::string_view sizes = MapLoader::headerLine(file.data(), file.size(), bodyOffset);
+    size_t separator = sizes.find(' ');
+
+    report.heightError = MapLoader::parseDimension(sizes.substr(0, separator), height);
+    report.widthError = MapLoader::parseDimension(sizes.substr(separator + 1), width);
+
+    if (report.heightError == MapLoader::DimensionError::NONE && report.widthError == MapLoader::DimensionError::NONE
+        && width > Level::MAX_CELLS / height)
+    {
+        report.widthError = MapLoader::DimensionError::TOO_LARGE;
+    }
+
+    if (report.heightError != MapLoader::DimensionError::NONE || report.widthError != MapLoader::DimensionError::NONE)
+    {
+        report.status = LoadReport::Status::BAD_DIMENSION;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Berechnet zu einer geprüften Karte alles, was zum Spielen gebraucht wird.
+ *
+ * Setzt den Status in report: INVALID, wenn die Prüfung einen Fehler gefunden hat,
+ * UNREACHABLE, wenn das Ziel nicht erreichbar ist.
+ *
+ * @param previous vorherige Fassung gleicher Größe, deren Übergangstabelle für die
+ *                 Spalten außerhalb von dirtyBlocks übernommen wird, oder nullptr
+ */
+void buildLevel(Level& level, LoadReport& report, ThreadPool* pool, const Level* previous = nullptr,
+                const std::vector<uint8_t>* dirtyBlocks = nullptr)
+{
+    if (!report.validation.ok())
+    {
+        report.status = LoadReport::Status::INVALID;
+        return;
+    }
+
+    level.startPos = {report.validation.startRow + 1, report.validation.startCol};
+    level.goalPos = {report.validation.goalRow + 1, report.validation.goalCol};
+    level.platforms.build(level.grid);
+    Level::buildTransitions(level, pool, previous, dirtyBlocks);
+
+    Solution solution = Reachability::solve(level, pool);
+    if (!solution.reachable)
+    {
+        report.status = LoadReport::Status::UNREACHABLE;
+        return;
+    }
+    level.solution = std::move(solution.inputs);
+}
+
+}
+
+///@brief True, wenn die Karte geladen und gültig ist
+bool LoadReport::ok() const
+{
+    return status == Status::OK;
+}
+
+/**
+ * @brief Lädt eine Karte aus einer Textdatei und prüft sie.
+ *
+ * Gibt nichts aus, alle Fehler stehen im Ergebnis. Bei einer gültigen Karte sind
+ * Start- und Zielposition gesetzt, Plattformindex und Übergangstabelle aufgebaut
+ * und die kürzeste Lösung gefunden. Eine Karte, deren Ziel nach den Spielregeln
+ * nicht erreichbar ist, ist ungültig (UNREACHABLE).
+ *
+ * @param path Pfad der .txt-Datei
+ * @param level wird gefüllt
+ * @param rules Regelprofil für Prüfung und Spiel
+ * @param pool Threads für die parallele Prüfung und Suche oder nullptr
+ * @return Ergebnis mit Status und Fehlerdetails
+ */
+LoadReport Level::loadText(const std::string& path, Level& level, RuleProfile rules, ThreadPool* pool)
+{
+    LoadReport report;
+    MappedFile file(path);
+    size_t bodyOffset = 0, height = 0, width = 0;
+
+    if (!readHeader(file, report, bodyOffset, height, width)) return report;
+
+    //zu kurze Zeilen bleiben mit Leerzeichen aufgefüllt, zu lange werden abgeschnitten
+    level.grid.assign(height, width, ' ');
+    MapLoader::copyRows(file.data() + bodyOffset, file.size() - bodyOffset, level.grid);
+
+    level.rules = rules;
+    RuleLimits limits = limitsOf(rules);
+    report.validation = MapValidator::validate(level.grid, limits.maxSpace, limits.playerHeight, pool);
+    buildLevel(level, report, pool);
+
+    return report;
+}
+
+/**
+ * @brief Lädt eine eingebaute Karte.
+ *
+ * Mit den Standardregeln (ClassicRules) ist die Karte schon beim Übersetzen geprüft
+ * und bereinigt, Start, Ziel und Lösung stehen fest. Es werden nur die Zeilen kopiert
+ * und Plattformindex, Bitebenen und Übergangstabelle berechnet. Mit einem anderen
+ * Profil wird die Karte wie eine Textdatei geprüft und gelöst.
+ *
+ * @param map eingebaute Karte, siehe headers/builtinMaps.h
+ * @param level wird gefüllt
+ * @param rules Regelprofil für Prüfung und Spiel
+ * @param pool Threads für Prüfung, Übergangstabelle und Suche oder nullptr
+ * @return Ergebnis wie bei loadText(), mit builtin gesetzt; mit ClassicRules immer OK
+ */
+LoadReport Level::loadBuiltin(const BuiltinMap& map, Level& level, RuleProfile rules, ThreadPool* pool)
+{
+    LoadReport report;
+    report.builtin = true;
+    level.rules = rules;
+
+    bool checked = rules == ClassicRules::PROFILE;
+    std::string_view cells = checked ? map.cleaned : map.cells;
+
+    level.grid.assign(map.height, map.width, ' ');
+    for (size_t row = 0; row < map.height; ++row)
+    {
+        std::memcpy(level.grid.row(row), cells.data() + row * map.width, map.width);
+    }
+
+    if (!checked)
+    {
+        RuleLimits limits = limitsOf(rules);
+        report.validation = MapValidator::validate(level.grid, limits.maxSpace, limits.playerHeight, pool);
+        buildLevel(level, report, pool);
+        return report;
+    }
+
+    level.startPos = {map.check.startRow + 1, map.check.startCol};
+    level.goalPos = {map.check.goalRow + 1, map.check.goalCol};
+    level.solution.assign(map.solution.data(), map.solution.size());
+    level.platforms.build(level.grid);
+    Level::buildTransitions(level, pool);
+
+    return report;
+}
+
+/**
+ * @brief Lädt eine geänderte Karte neu und prüft nur, was sich geändert hat.
+ *
+ * source ist die unbereinigte Fassung der Karte, wie sie zuletzt gelesen wurde. Haben
+ * sich Höhe und Breite nicht geändert und war die vorherige Fassung gültig, werden nur
+ * die geänderten Zeilen übernommen (MapLoader::updateRows()) und nur die Spaltenblöcke
+ * mit Änderungen neu geprüft (MapValidator::revalidate()), der Rest der bereinigten
+ * Karte wird aus previous kopiert. Die Symbole S und O der unveränderten Spalten sind
+ * die aus previous; liegt das bisherige S oder O in einer geänderten Spalte, sind die
+ * übrigen Symbole unbekannt und es wird die ganze Karte geprüft. Sonst, oder ohne
+ * source, wird wie mit loadText() alles geladen und geprüft.
+ *
+ * Von der Übergangstabelle werden nur die Spalten neben Änderungen neu berechnet.
+ * Plattformindex, Bitebenen und Lösung werden ganz neu berechnet.
+ *
+ * @param path Pfad der .txt-Datei
+ * @param previous die vorherige, gültige Fassung oder nullptr
+ * @param source vorher die unbereinigte vorherige Fassung (oder leer), danach die neue
+ * @param level wird gefüllt; bleibt leer, wenn sich nichts geändert hat (changedRows == 0)
+ * @param rules Regelprofil für Prüfung und Spiel; mit einem anderen als bei previous wird alles neu geprüft
+ * @param pool Threads für die parallele Prüfung und Suche oder nullptr
+ * @return Ergebnis wie bei loadText(), dazu incremental, changedRows und checkedColumns
+ */
+LoadReport Level::reloadText(const std::string& path, const Level* previous, Grid& source, Level& level,
+                             RuleProfile rules, ThreadPool* pool)
+{
+    LoadReport report;
+    level.rules = rules;
+    RuleLimits limits = limitsOf(rules);
+    MappedFile file(path);
+    size_t bodyOffset = 0, height = 0, width = 0;
+
+    if (!readHeader(file, report, bodyOffset, height, width)) return report;
+
+    const char* body = file.data() + bodyOffset;
+    size_t size = file.size() - bodyOffset;
+
+    bool sameSize = previous != nullptr && previous->rules == rules && source.getHeight() == height
+                    && source.getWidth() == width && previous->grid.getHeight() == height
+                    && previous->grid.getWidth() == width;
+
+    if (!sameSize)
+    {
+        source.assign(height, width, ' ');
+        MapLoader::copyRows(body, size, source);
+
+        level.grid = source;
+        report.validation = MapValidator::validate(level.grid, limits.maxSpace, limits.playerHeight, pool);
+        report.changedRows = height;
+        report.checkedColumns = width;
+
+        buildLevel(level, report, pool);
+        return report;
+    }
+
+    std::vector<uint8_t> dirtyBlocks;
+    report.incremental = true;
+    report.changedRows = MapLoader::updateRows(body, size, source, dirtyBlocks);
+
+    if (report.changedRows == 0) return report;
+
+    if (dirtyBlocks[previous->startPos[1] / Grid::ALIGNMENT] != 0
+        || dirtyBlocks[previous->goalPos[1] / Grid::ALIGNMENT] != 0)
+    {
+        level.grid = source;
+        report.validation = MapValidator::validate(level.grid, limits.maxSpace, limits.playerHeight, pool);
+        report.checkedColumns = width;
+    } else {
+        //bereinigte alte Karte, in den geänderten Blöcken die neue Fassung
+        level.grid = previous->grid;
+        for (size_t row = 0; row < height; ++row)
+        {
+            for (size_t block = 0; block < dirtyBlocks.size(); ++block)
+            {
+                if (dirtyBlocks[block] == 0) continue;
+
+                size_t offset = block * Grid::ALIGNMENT;
+                std::memcpy(level.grid.row(row) + offset, source.row(row) + offset, Grid::ALIGNMENT);
+            }
+        }
+
+        report.validation = MapValidator::revalidate(level.grid, dirtyBlocks, limits.maxSpace, limits.playerHeight,
+                                                     pool);
+        report.validation.recordStart(previous->startPos[0] - 1, previous->startPos[1]);
+        report.validation.recordGoal(previous->goalPos[0] - 1, previous->goalPos[1]);
+
+        auto blocks = static_cast<size_t>(std::count(dirtyBlocks.begin(), dirtyBlocks.end(), 1));
+        report.checkedColumns = std::min(blocks * Grid::ALIGNMENT, width);
+    }
+
+    buildLevel(level, report, pool, previous, &dirtyBlocks);
+    return report;
+}
+
+/**
+ * @brief Berechnet die Übergangstabelle eines Levels mit fertigem Plattformindex.
+ *
+ * Bei hohen Karten (TilePlanes::paysOff()) werden dafür die Bitebenen gebaut und
+ * danach wieder freigegeben. Im Spiel schlägt Physics::step() nur noch in der
+ * Tabelle nach, die Ebenen würden das Level nur größer machen.
+ *
+ * @param previous vorherige Fassung gleicher Größe, deren Tabelle für die Spalten
+ *                 außerhalb von dirtyBlocks übernommen wird, oder nullptr
+ */
+void Level::buildTransitions(Level& level, ThreadPool* pool, const Level* previous,
+                             const std::vector<uint8_t>* dirtyBlocks)
+{
+    if (TilePlanes::paysOff(level.grid))
+    {
+        level.planes.build(level.grid);
+    }
+
+    if (previous != nullptr && dirtyBlocks != nullptr && !previous->transitions.empty())
+    {
+        level.transitions.update(level, *previous, *dirtyBlocks, pool);
+    } else {
+        level.transitions.build(level, pool);
+    }
+
+    level.planes.clear();
+}
@@ -0,0 +1,115 @@
+#include "headers/levelCache.h"
+#include "headers/builtinMaps.h"
+#include "headers/mapCache.h"
+#include <filesystem>
+
+/**
+ * @brief Konstruktor, es wird noch nichts geladen.
+ * @param directory Kartenordner mit '/' am Ende, z.B. "maps/"
+ * @param rules Regelprofil für alle Karten
+ */
+LevelCache::LevelCache(std::string directory, RuleProfile rules) : DIRECTORY(std::move(directory)), RULES(rules)
+{
+}
+
+/**
+ * @brief Gibt die Karte zurück und lädt sie beim ersten Aufruf.
+ *
+ * Der Aufruf blockiert, solange die Karte geladen wird, auch wenn ein anderer Thread
+ * sie lädt. Scheitert das Laden, wird beim nächsten Aufruf erneut geladen.
+ *
+ * @param name Dateiname wie im Menü, z.B. "spiel.txt"
+ * @return geteilte Karte, nullptr, wenn der Name nicht erlaubt, die Karte nicht
+ *         vorhanden oder ungültig ist oder nicht in den Speicher passt
+ */
+std::shared_ptr<const Level> LevelCache::get(const std::string& name)
+{
+    if (!isMapName(name)) return nullptr;
+
+    std::promise<std::shared_ptr<const Level>> promise;
+    std::shared_future<std::shared_ptr<const Level>> result;
+    bool first = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto found = levels.find(name);
+        if (found == levels.end())
+        {
+            found = levels.emplace(name, promise.get_future().share()).first;
+            first = true;
+        }
+        result = found->second;
+    }
+
+    if (first) //außerhalb der Sperre, andere Karten laden gleichzeitig
+    {
+        std::shared_ptr<const Level> level;
+        try
+        {
+            level = load(name);
+        }
+        catch (const std::exception&) //z.B. bad_alloc; ohne Wert würden alle Wartenden ewig blockieren
+        {
+            level = nullptr;
+        }
+        bool failed = level == nullptr;
+        promise.set_value(std::move(level));
+
+        //nur geladene Karten bleiben, sonst wächst levels mit jedem Namen, den ein Spieler schickt;
+        //wer schon wartet, hat result und bekommt trotzdem nullptr
+        if (failed)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            levels.erase(name);
+        }
+    }
+
+    return result.get();
+}
+
+///@brief Anzahl der geladenen Karten, auch solcher, die gerade noch geladen werden
+size_t LevelCache::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return levels.size();
+}
+
+/**
+ * @brief Nur Dateinamen ohne Ordner, die auf .txt enden; keine Pfade aus dem Netz.
+ */
+bool LevelCache::isMapName(const std::string& name)
+{
+    return name.size() > 4 && name.size() <= 255 && name[0] != '.'
+           && name.find('/') == std::string::npos && name.find('\0') == std::string::npos
+           && name.compare(name.size() - 4, 4, ".txt") == 0;
+}
+
+/**
+ * @brief Lädt eine Karte wie Map::loadEntry() beim ersten Laden, ohne Ausgabe.
+ * @return nullptr, wenn die Karte nicht vorhanden oder ungültig ist
+ */
+std::shared_ptr<const Level> LevelCache::load(const std::string& name) const
+{
+    std::string path = DIRECTORY + name;
+    auto loaded = std::make_shared<Level>();
+
+    std::error_code error;
+    if (!std::filesystem::is_regular_file(path, error))
+    {
+        for (const auto& builtin : BUILTIN_MAPS)
+        {
+            if (builtin.name == name)
+            {
+                return Level::loadBuiltin(builtin, *loaded, RULES).ok() ? loaded : nullptr;
+            }
+        }
+        return nullptr;
+    }
+
+    if (MapCache::load(path, *loaded, RULES)) return loaded;
+
+    if (!Level::loadText(path, *loaded, RULES).ok()) return nullptr;
+
+    MapCache::store(path, *loaded);
+    return loaded;
+}
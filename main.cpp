@@ -1,12 +1,147 @@
 #include "headers/gameController.h"
+#include "headers/profiler.h"
+#include <filesystem>
 
-int main () {
-    GameController game = GameController();
+/**
+ * Aufruf: adventure [--threads N] [--rules PROFIL] [--render AUSGABE] [--capture DATEI] [--full-map]
+ *                  [--dead-zone N] [--line-mode] [--tick MS] [--debug] [--hud] [--trace DATEI]
+ *                  [--record ORDNER] [--no-record]
+ *   --threads N    Karten mit N Threads prüfen (0 = alle Hardware-Threads, Standard 1, höchstens 1024)
+ *   --rules PROFIL Spielregeln: classic (Standard, Spieler ein Feld hoch) oder tall
+ *                  (Spieler drei Zeilen hoch, Plattformen auf Körperhöhe halten ihn auf)
+ *   --render AUSGABE  Bilder ins terminal (Standard) oder null: gar nicht zeichnen,
+ *                  für Messungen und Skripte
+ *   --capture DATEI  Bilder statt ins Terminal als asciicast in DATEI aufnehmen,
+ *                  abspielen mit tools/replay --cast DATEI
+ *   --full-map     immer die ganze Karte zeichnen, auch wenn sie größer als das Terminal ist
+ *   --dead-zone N  der Ausschnitt läuft mit, wenn der Spieler näher als N Zellen an
+ *                  seinen Rand kommt (0 bis 100000, Standard: ein Viertel des Ausschnitts)
+ *   --line-mode    Züge mit Enter bestätigen statt Tasten in Echtzeit zu lesen
+ *                  (ohne Terminal, z.B. aus einer Pipe, immer so)
+ *   --tick MS      Länge eines Spieltakts im Echtzeitmodus (1 bis 10000, Standard 20 ms)
+ *   --debug        nach jedem Spiel die Latenz von der Taste bis zum Bild ausgeben
+ *   --hud          nach jedem Zug die Messwerte des Profilers ausgeben
+ *   --trace DATEI  alle Messungen als Chrome trace_event JSON schreiben
+ *   --record ORDNER  jedes Spiel in ORDNER aufzeichnen, der Ordner wird angelegt
+ *                  (Standard: logs/, aber nur wenn es den Ordner gibt)
+ *   --no-record    nichts aufzeichnen
+ *
+ * --hud und --trace brauchen einen Build mit -DADVENTURE_PROFILE. In so einem Build
+ * wird beim Beenden immer eine Zusammenfassung der Messungen ausgegeben.
+ */
+int main (int argc, char* argv[]) {
+    GameOptions options;
+    std::string tracePath;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+
+        try
+        {
+            if (argument == "--threads" && i + 1 < argc)
+            {
+                long threads = std::stol(argv[++i]);
+                if (threads < 0 || threads > 1024) throw std::out_of_range("threads");
+                options.validationThreads = static_cast<size_t>(threads);
+            } else if (argument == "--rules" && i + 1 < argc)
+            {
+                if (!parseRuleProfile(argv[++i], options.rules))
+                {
+                    std::cerr << "Unbekannte Regeln: " << argv[i] << " (classic oder tall)\n";
+                    return 1;
+                }
+            } else if (argument == "--render" && i + 1 < argc)
+            {
+                std::string sink = argv[++i];
+                if (sink == "terminal")
+                {
+                    options.render = RenderSink::TERMINAL;
+                } else if (sink == "null")
+                {
+                    options.render = RenderSink::NONE;
+                } else {
+                    std::cerr << "Unbekannte Ausgabe: " << sink << " (terminal oder null)\n";
+                    return 1;
+                }
+            } else if (argument == "--capture" && i + 1 < argc)
+            {
+                options.render = RenderSink::CAPTURE;
+                options.capturePath = argv[++i];
+            } else if (argument == "--full-map")
+            {
+                options.fullMap = true;
+            } else if (argument == "--dead-zone" && i + 1 < argc)
+            {
+                long cells = std::stol(argv[++i]);
+                if (cells < 0 || cells > 100000) throw std::out_of_range("dead-zone");
+                options.deadZone = static_cast<size_t>(cells);
+            } else if (argument == "--line-mode")
+            {
+                options.lineMode = true;
+            } else if (argument == "--tick" && i + 1 < argc)
+            {
+                long milliseconds = std::stol(argv[++i]);
+                if (milliseconds < 1 || milliseconds > 10000) throw std::out_of_range("tick");
+                options.tickMs = static_cast<size_t>(milliseconds);
+            } else if (argument == "--debug")
+            {
+                options.debug = true;
+            } else if (argument == "--hud")
+            {
+                options.hud = true;
+            } else if (argument == "--trace" && i + 1 < argc)
+            {
+                tracePath = argv[++i];
+            } else if (argument == "--record" && i + 1 < argc)
+            {
+                options.recordDirectory = argv[++i];
+
+                std::error_code error;
+                std::filesystem::create_directories(options.recordDirectory, error);
+            } else if (argument == "--no-record")
+            {
+                options.recordDirectory.clear();
+            } else {
+                std::cerr << "Unbekannte Option: " << argument << "\n";
+                return 1;
+            }
+        }
+        catch (const std::logic_error&)
+        {
+            std::cerr << "Falsche Zahl für " << argument << "\n";
+            return 1;
+        }
+    }
+
+    if ((options.hud || !tracePath.empty()) && !Profiler::COMPILED)
+    {
+        std::cerr << "--hud und --trace brauchen einen Build mit -DADVENTURE_PROFILE\n";
+        return 1;
+    }
+
+    if (!tracePath.empty())
+    {
+        Profiler::enableTrace(); //vor dem Laden, damit die Ladephasen im Trace sind
+    }
+
+    GameController game = GameController(options);
 
     while(!game.exit())
     {
         game.processInput();
     }
 
+    if (Profiler::COMPILED)
+    {
+        Profiler::printSummary(std::cerr);
+    }
+
+    if (!tracePath.empty() && !Profiler::writeTrace(tracePath))
+    {
+        std::cerr << tracePath << " konnte nicht geschrieben werden\n";
+        return 1;
+    }
+
     return 0;
 }
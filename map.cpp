@@ -1,6 +1,10 @@
 #include "headers/map.h"
+#include "headers/builtinMaps.h"
+#include "headers/mapCache.h"
+#include "headers/profiler.h"
+#include <algorithm>
 #include <filesystem>
-#include <fstream>
+#include <new>
 
 namespace fs = std::filesystem;
 
@@ -8,14 +12,19 @@ namespace fs = std::filesystem;
  * @brief Konstruktor, der die Map initialisiert und versucht, die verfügbaren Karten zu laden.
  *
  * Setzt die Start- und Zielpositionen sowie die Dimensionen der Map auf 0 und
- * ruft loadMaps() auf, um verfügbare Karten zu laden.
+ * ruft loadMaps() auf, um verfügbare Karten zu laden. Die Karten werden danach im
+ * Hintergrund geladen und geprüft, das Menü kann also sofort gezeigt werden.
+ * Der Kartenordner wird schon vorher beobachtet, damit refresh() keine Änderung verpasst.
  *
- * MAX_SPACE und PLAYER_HEIGHT sollen eigentlich gleich sein, da im Muster der Spieler 3 Zeilen Hoch ist.
- * Bei mir ist aber der Spieler als einzelne Symbol dargestellt.
+ * Alle Karten werden mit einem Regelprofil geprüft und gespielt. Mit ClassicRules ist der
+ * Spieler ein einzelnes Symbol, mit TallRules drei Zeilen hoch wie im Muster der Aufgabe.
  *
+ * @param validationThreads Threads für die Prüfung einer Karte, 0 für alle Hardware-Threads,
+ *                          1 für keine parallele Prüfung
+ * @param rules Regelprofil für alle Karten
  * @post Die Map ist initialisiert und bereit zur Auswahl einer Karte.
  */
-Map::Map():MAX_SPACE(3), PLAYER_HEIGHT(1), MAP_DIRECTORY("maps/")
+Map::Map(size_t validationThreads, RuleProfile rules):closing(false), loadVersion(0), RULES(rules), MAP_DIRECTORY("maps/")
 {
     goalPos = {0, 0};
     startPos = {0, 0};
@@ -25,14 +34,49 @@ Map::Map():MAX_SPACE(3), PLAYER_HEIGHT(1), MAP_DIRECTORY("maps/")
 
     mapOK = false;
 
+    if (validationThreads == 0)
+    {
+        validationThreads = ThreadPool::hardwareThreads();
+    }
+
+    //der aufrufende Thread prüft mit, der Pool braucht also einen Thread weniger
+    if (validationThreads > 1)
+    {
+        validationPool = std::make_unique<ThreadPool>(validationThreads - 1);
+    }
+
+    watcher = std::make_unique<MapWatcher>(MAP_DIRECTORY);
+
     if(!loadMaps())
     {
         std::cout << "\nKeine Karten im Ordner!\n";
     } else {
         std::cout << "\nHochladen erfolgreich\n";
     }
+    startLoading();
+
     std::cout << "Um Ihre eigene Karte zu verwenden, laden Sie bitte die .txt-Datei in den Root-Ordner des Projekts.\n"
-                 "Bitte entfernen Sie alle .txt-Dateien, die keine Karten sind, aus dem Ordner. Starten Sie nach dem Hochladen das Programm neu.";
+                 "Bitte entfernen Sie alle .txt-Dateien, die keine Karten sind, aus dem Ordner.";
+    if (watcher->isOpen())
+    {
+        std::cout << " Neue und geänderte Karten erscheinen beim nächsten Anzeigen des Menüs.";
+    } else {
+        std::cout << " Starten Sie nach dem Hochladen das Programm neu.";
+    }
+}
+
+/**
+ * @brief Destruktor, bricht das Laden im Hintergrund ab.
+ *
+ * Karten, deren Laden schon läuft, werden noch fertig geladen, alle anderen übersprungen.
+ */
+Map::~Map()
+{
+    {
+        std::lock_guard<std::mutex> lock(catalogMutex);
+        closing = true;
+    }
+    loaderPool.reset();
 }
 
 /**
@@ -40,22 +84,36 @@ Map::Map():MAX_SPACE(3), PLAYER_HEIGHT(1), MAP_DIRECTORY("maps/")
  *
  * BITTE COMPILE.TXT UND TEST.TXT aus dem Ordner entfernen.
  *
- * Geht alle Dateien durch und fügt Karten zur Liste der verfügbaren Karten hinzu.
+ * Geht alle Dateien durch und fügt Karten zur Liste der verfügbaren Karten hinzu,
+ * danach die eingebauten Karten, zu denen es keine Datei gibt. Fehlt der Kartenordner,
+ * gibt es nur die eingebauten Karten.
  * @return Gibt zurück, ob mindestens eine Karte gefunden wurde.
- * @post Die Liste der verfügbaren Karten ist aktualisiert.
+ * @post Die Liste der verfügbaren Karten und der Katalog sind aktualisiert.
  */
 bool Map::loadMaps()
 {
-    bool mapFound = false;
-    for(const auto& entry : fs::directory_iterator(MAP_DIRECTORY)) //durch alle Dateien gehen
+    std::error_code error;
+    for(const auto& entry : fs::directory_iterator(MAP_DIRECTORY, error)) //durch alle Dateien gehen
     {
         if(entry.is_regular_file() && entry.path().extension() == ".txt")
         {
             addNew(entry.path().filename().string());
-            mapFound = true;
+            catalog.emplace_back();
+        }
+    }
+
+    for (const auto& builtin : BUILTIN_MAPS)
+    {
+        std::string name(builtin.name);
+        if (findEntry(name) == NO_ENTRY)
+        {
+            addNew(name);
+            catalog.emplace_back();
+            catalog.back().builtin = &builtin;
         }
     }
-    return mapFound;
+
+    return !availableMaps.empty();
 }
 
 /**
@@ -70,278 +128,470 @@ void Map::addNew(const std::string& mapFileName)
 }
 
 /**
- * @brief Wählt eine Karte aus der Liste der verfügbaren Karten und lädt sie.
+ * @brief Startet das Laden und Prüfen aller Karten im Hintergrund.
  *
- * Diese Methode lädt die Karte, die durch den Index spezifiziert wird, und überprüft ihre Gültigkeit.
- * @param index Der Index der auszuwählenden Karte in der Liste der verfügbaren Karten.
- * @return Gibt zurück, ob die Karte erfolgreich ausgewählt und geladen wurde.
- * @pre Der Index muss innerhalb der Grenzen der verfügbaren Kartenliste liegen.
- * @post Die Karte ist geladen, falls sie gültig ist.
- * @see setDimension()
- * @see checkCurrentMap()
+ * Jede Karte ist eine eigene Aufgabe, es werden so viele Karten gleichzeitig geladen,
+ * wie es Hardware-Threads gibt. Der Pool bleibt für Karten, die refresh() findet.
  */
-bool Map::selectMap(const size_t index)
+void Map::startLoading()
 {
-    std::ifstream map (MAP_DIRECTORY + availableMaps.at(index));
+    loaderPool = std::make_unique<ThreadPool>(
+            std::max<size_t>(std::min(ThreadPool::hardwareThreads(), availableMaps.size()), 1));
 
-    if (map.is_open())
+    for (size_t index = 0; index < availableMaps.size(); ++index)
     {
-        std::string line, sizes;
-
-        std::getline(map, sizes);
-        size_t separator = sizes.find(' ');
-
-        height = setDimension(sizes.substr(0, separator));
-        width = setDimension(sizes.substr(separator + 1));
-
-        if(width == 0 || height == 0) return false;
-
-        renderMap2D.clear(); //wenn eine neue Karte gewählt wird, müssen alle alte Speicherzellen leer sein
-        renderMap2D.resize(height, std::vector<char>(width, ' '));
+        queueEntry(index);
+    }
+}
 
-        size_t row = 0;
+/**
+ * @brief Übernimmt neue, geänderte und gelöschte Karten aus dem Kartenordner.
+ *
+ * Wird vor dem Anzeigen des Menüs aufgerufen, nur im Hauptthread. Neue Karten kommen
+ * ans Ende der Liste, gelöschte verschwinden, geänderte werden im Hintergrund neu
+ * geladen (siehe loadEntry()). Jede Änderung wird in einer Zeile gemeldet.
+ *
+ * @return True, wenn sich etwas geändert hat
+ * @see MapWatcher
+ */
+bool Map::refresh()
+{
+    std::vector<MapWatcher::Event> events = watcher->poll();
+    if (events.empty()) return false;
 
-        while ( std::getline (map,line) )
+    //Ereignisse verloren: den Ordner mit dem Katalog vergleichen
+    if (events.front().kind == MapWatcher::Event::Kind::RESCAN)
+    {
+        events.clear();
+        for (const auto& name : availableMaps)
+        {
+            events.push_back({MapWatcher::Event::Kind::REMOVED, name});
+        }
+        //fehlt der Kartenordner, gelten wie in loadMaps() nur noch die eingebauten Karten
+        std::error_code error;
+        for (const auto& entry : fs::directory_iterator(MAP_DIRECTORY, error))
         {
-            for (size_t col = 0; col < width; ++col) {
-                char input = (col < line.length()) ? line[col] : ' '; // wenn es nicht genug leerzeichen im line gibt
-                renderMap2D.at(row).at(col) = input;
+            if (entry.is_regular_file() && entry.path().extension() == ".txt")
+            {
+                events.push_back({MapWatcher::Event::Kind::CHANGED, entry.path().filename().string()});
             }
-            ++row;
         }
+    }
 
-        map.close();
+    for (const auto& event : events)
+    {
+        size_t index = findEntry(event.name);
+        std::error_code error;
+        bool exists = fs::is_regular_file(MAP_DIRECTORY + event.name, error);
 
-        mapOK = checkCurrentMap();
+        const BuiltinMap* builtin = findBuiltin(event.name);
 
-        if(!mapOK)
+        if (!exists)
         {
-            std::cout << "Die hochgeladene Karte ist ungültig\n";
-            return false;
-        }
+            if (index == NO_ENTRY || catalog[index].builtin != nullptr) continue;
 
-        return true;
-
-    } else {
-        std::cout << "Datei konnte nicht geöffnet werden\n";
-        return false;
-    }
-}
+            if (builtin != nullptr)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(catalogMutex);
+                    catalog[index] = CatalogEntry();
+                    catalog[index].builtin = builtin;
+                }
+                std::cout << "Karte entfernt: " << event.name << ", die eingebaute Karte gilt wieder\n";
+                queueEntry(index);
+                continue;
+            }
 
-///@brief Zeichnet die Karte
-///@param bufferMap ist die Karte mit Player drin
-void Map::renderMap(const std::vector<std::vector<char>>& bufferMap) const
-{
-    for (auto & row : bufferMap) {
-        for (char col : row) {
-            std::cout << col;
+            {
+                std::lock_guard<std::mutex> lock(catalogMutex);
+                availableMaps.erase(availableMaps.begin() + static_cast<std::ptrdiff_t>(index));
+                catalog.erase(catalog.begin() + static_cast<std::ptrdiff_t>(index));
+            }
+            std::cout << "Karte entfernt: " << event.name << "\n";
+        } else if (index == NO_ENTRY)
+        {
+            {
+                std::lock_guard<std::mutex> lock(catalogMutex);
+                addNew(event.name);
+                catalog.emplace_back();
+            }
+            std::cout << "Neue Karte: " << event.name << "\n";
+            queueEntry(availableMaps.size() - 1);
+        } else if (event.kind == MapWatcher::Event::Kind::CHANGED)
+        {
+            //die Datei ersetzt ab jetzt die eingebaute Karte
+            if (builtin != nullptr)
+            {
+                std::lock_guard<std::mutex> lock(catalogMutex);
+                catalog[index] = CatalogEntry();
+            }
+            std::cout << "Karte geändert: " << event.name << "\n";
+            queueEntry(index);
         }
-        std::cout << "\n";
     }
+
+    return true;
 }
 
 /**
- * @brief Erstellt buffer map und zeichnet die Karte mit P-symbol (player)
- * @param x  x-position von Player
- * @param y  y-position von Player
+ * @brief Lädt eine Karte des Katalogs (neu) im Hintergrund.
+ *
+ * Die Karte gilt bis zum Ende des Auftrags als LOADING, selectMap() wartet also auf
+ * die neue Fassung. Ein noch laufender älterer Auftrag für dieselbe Karte wird verworfen.
+ *
+ * @param index Index der Karte in availableMaps
  */
-void Map::renderPlayer(size_t x, size_t y) const
+void Map::queueEntry(size_t index)
 {
-    std::vector<std::vector<char>> bufferMap = renderMap2D;
+    std::string name;
+    uint64_t version;
+    {
+        std::lock_guard<std::mutex> lock(catalogMutex);
 
-    bufferMap[y][x] = 'P';
+        CatalogEntry& entry = catalog.at(index);
+        entry.state = MapState::LOADING;
+        entry.version = version = ++loadVersion;
+        name = availableMaps[index];
+    }
 
-    renderMap(bufferMap);
+    loaderPool->submit([this, name, version] { loadEntry(name, version); });
 }
 
 /**
- * @brief Überprüft die aktuell geladene Karte auf Gültigkeit basierend auf den Spielregeln.
+ * @brief Lädt und prüft eine Karte des Katalogs, läuft in einem Thread des loaderPool.
+ *
+ * Eine eingebaute Karte wird ohne Datei übernommen (siehe Level::loadBuiltin()). Beim
+ * ersten Laden wird eine aktuelle .amap-Datei neben der Karte ohne erneute Prüfung
+ * geladen. Sonst wird die .txt-Datei gelesen und geprüft und bei Erfolg die .amap-Datei
+ * geschrieben. Gibt es schon eine gültige Fassung mit ihrer unbereinigten Karte (nach
+ * einer Änderung im laufenden Spiel), werden nur die geänderten Zeilen übernommen und
+ * die geänderten Spalten neu geprüft. Es wird nichts ausgegeben, das Ergebnis steht
+ * danach im Katalog.
  *
- * Geht alle Zellen der Karte durch und stellt sicher, dass die Karte den Spielregeln entspricht, wie z.B.
- * die korrekte Platzierung von Plattformen und Leitern sowie die Start- und Zielsymbole. Zuweist auch
- * die Start- und Zielposition
- * @return Gibt zurück, ob die aktuelle Karte gültig ist.
- * @pre renderMap2D darf nicht leer sein
- * @post Das Attribut mapOK ist gesetzt, um anzuzeigen, ob die Karte gültig ist.
- * @see isLadderValid()
- * @see isPlatformValid()
- * @see symbolCheck()
+ * @param name Dateiname der Karte in availableMaps
+ * @param version Nummer des Auftrags, siehe queueEntry()
+ * @see Level::reloadText()
+ * @see MapCache
  */
-bool Map::checkCurrentMap()
+void Map::loadEntry(const std::string& name, uint64_t version)
 {
-    for (size_t row = 0; row < height; ++row)
+    PROFILE_SCOPE("map.load");
+
+    std::shared_ptr<const Level> previous;
+    Grid source;
+    const BuiltinMap* builtin;
+    {
+        std::lock_guard<std::mutex> lock(catalogMutex);
+        if (closing) return;
+
+        size_t index = findEntry(name);
+        if (index == NO_ENTRY || catalog[index].version != version) return;
+
+        previous = catalog[index].level;
+        if (catalog[index].source) source = *catalog[index].source;
+        builtin = catalog[index].builtin;
+    }
+
+    std::string path = MAP_DIRECTORY + name;
+
+    auto loaded = std::make_shared<Level>();
+    LoadReport report;
+
+    //ein Fehler hier darf weder den Thread noch das Spiel beenden, die Karte ist dann nur ungültig
+    try
     {
-        for (size_t col = 0; col < width; ++col)
+        if (builtin != nullptr)
+        {
+            report = Level::loadBuiltin(*builtin, *loaded, RULES, validationPool.get());
+        } else if (!previous && MapCache::load(path, *loaded, RULES))
         {
-            char cell = renderMap2D[row][col];
-            switch (cell)
+            report.fromCache = true;
+        } else {
+            report = Level::reloadText(path, previous.get(), source, *loaded, RULES, validationPool.get());
+
+            if (report.ok() && report.changedRows > 0)
             {
-                case '-':
-                    if(!isPlatformValid(row, col))
-                    {
-                        return false;
-                    }
-                    break;
-                case 'H':
-                    if(!isLadderValid(row, col))
-                    {
-                        return false;
-                    }
-                    break;
-                case 'S':
-                    if(!symbolCheck(row, col))
-                    {
-                        return false;
-                    }
-
-                    startPos = {row + 1, col};
-                    renderMap2D[row][col] = ' ';
-                    break;
-                case 'O':
-                    if(!symbolCheck(row, col))
-                    {
-                        return false;
-                    }
-
-                    goalPos = {row + 1, col};
-                    break;
-                default:
-                {
-                    if (cell != ' ')
-                    {
-                        renderMap2D[row][col] = ' ';
-                    }
-                    break;
-                }
+                MapCache::store(path, *loaded);
             }
         }
     }
-    return !(goalPos.at(0) == 0 || startPos.at(0) == 0); // ist O und S dabei?
+    catch (const std::bad_alloc&)
+    {
+        report = LoadReport();
+        report.status = LoadReport::Status::OUT_OF_MEMORY;
+    }
+    catch (const std::length_error&)
+    {
+        report = LoadReport();
+        report.status = LoadReport::Status::OUT_OF_MEMORY;
+    }
+    catch (const std::exception&)
+    {
+        report = LoadReport();
+        report.status = LoadReport::Status::OPEN_FAILED;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(catalogMutex);
+
+        size_t index = findEntry(name);
+        if (index == NO_ENTRY || catalog[index].version != version) return;
+
+        CatalogEntry& entry = catalog[index];
+        entry.report = report;
+        if (report.ok())
+        {
+            //unverändert (z.B. nur gespeichert): die bisherige Fassung bleibt
+            if (report.fromCache || report.builtin || report.changedRows > 0)
+            {
+                entry.level = std::move(loaded);
+                entry.source = source.empty() ? nullptr : std::make_shared<const Grid>(std::move(source));
+            }
+            entry.state = MapState::VALID;
+        } else {
+            entry.state = MapState::INVALID;
+        }
+    }
+    catalogChanged.notify_all();
 }
 
 /**
- * @brief Überprüft, ob das Symbol 'S' oder 'O' korrekt über einer Plattform platziert ist.
- *
- * Das Symbol ist korrekt platziert, wenn es genau eine Position über einer Plattform steht.
- *
- * @param row Die Zeilenposition des Symbols, die überprüft werden soll.
- * @param col Die Spaltenposition des Symbols, die überprüft werden soll.
- * @return True, wenn das Symbol korrekt platziert ist, sonst False.
- * @pre Die Position sollte innerhalb der Grenzen der Karte sein.
+ * @brief Eingebaute Karte mit diesem Dateinamen.
+ * @return nullptr, wenn es keine gibt
  */
-bool Map::symbolCheck(size_t row, size_t col) const
+const BuiltinMap* Map::findBuiltin(const std::string& name)
 {
-    size_t check_row = row + 2; //2 Eintraege runter
-    if (check_row + 1 > height || renderMap2D[check_row][col] != '-')
+    for (const auto& builtin : BUILTIN_MAPS)
     {
-        return false;
+        if (builtin.name == name) return &builtin;
     }
-    return true;
+    return nullptr;
+}
+
+/**
+ * @brief Index einer Karte in availableMaps.
+ * @pre Im Hauptthread oder mit catalogMutex
+ * @return NO_ENTRY, wenn es die Karte nicht (mehr) gibt
+ */
+size_t Map::findEntry(const std::string& name) const
+{
+    auto found = std::find(availableMaps.begin(), availableMaps.end(), name);
+    return found == availableMaps.end() ? NO_ENTRY : static_cast<size_t>(found - availableMaps.begin());
 }
 
 /**
- * @brief Überprüft, ob eine Leiter an der gegebenen Position korrekt platziert ist.
+ * @brief Wählt eine Karte aus der Liste der verfügbaren Karten und lädt sie.
  *
- * Eine Leiter ist dann korrekt platziert, wenn sie nicht im leeren Raum endet
+ * Die Karte wurde schon im Hintergrund geladen und geprüft, die Auswahl braucht also
+ * keine Ein-/Ausgabe. Ist die Karte noch nicht fertig, wird darauf gewartet.
  *
- * @param row Die Zeilenposition der Leiter, die überprüft werden soll.
- * @param col Die Spaltenposition der Leiter, die überprüft werden soll.
- * @return True, wenn die Leiter korrekt platziert ist, sonst False.
- * @pre Die Position sollte innerhalb der Grenzen der Karte sein.
+ * @param index Der Index der auszuwählenden Karte in der Liste der verfügbaren Karten.
+ * @return Gibt zurück, ob die Karte erfolgreich ausgewählt und geladen wurde.
+ * @pre Der Index muss innerhalb der Grenzen der verfügbaren Kartenliste liegen.
+ * @post Die Karte ist geladen, falls sie gültig ist.
+ * @see loadEntry()
  */
-bool Map::isLadderValid(size_t row, size_t col) const
+bool Map::selectMap(const size_t index)
 {
-    if (row == 0 || renderMap2D[row-1][col] == ' ')
+    PROFILE_SCOPE("map.select");
+
+    CatalogEntry entry;
     {
-        std::cout << "falsche Leiter " << row + 2 << " x " << col + 1 << "\n";
-        return false;
+        std::unique_lock<std::mutex> lock(catalogMutex);
+        const CatalogEntry& current = catalog.at(index);
+        catalogChanged.wait(lock, [&current] { return current.state != MapState::LOADING; });
+        entry = current;
     }
 
-    size_t check_row = row + 1;
-
-    while (renderMap2D[check_row][col] != '-')
+    if (entry.state != MapState::VALID)
     {
-        if (renderMap2D[check_row][col] == ' ' || check_row + 1 == height) //out of range oder leeres Zeichen
-        {
-            return false;
-        }
-
-        ++check_row; //naechste Leiter
+        reportLoadError(entry.report);
+        mapOK = false;
+        return false;
     }
 
+    //der Player kann noch die alte Karte benutzen, sie bleibt bis zu seinem reset() erhalten
+    level = entry.level;
+    mapName = availableMaps[index];
+    mapOK = true;
+
+    height = level->grid.getHeight();
+    width = level->grid.getWidth();
+    startPos = level->startPos;
+    goalPos = level->goalPos;
+
     return true;
 }
 
 /**
- * @brief Überprüft, ob eine Plattform an der gegebenen Position korrekt platziert ist.
+ * @brief Zustand einer Karte im Katalog.
+ * @param index Index der Karte in der Liste der verfügbaren Karten
+ * @return LOADING, solange die Karte im Hintergrund geladen wird
+ */
+Map::MapState Map::getMapState(size_t index) const
+{
+    std::lock_guard<std::mutex> lock(catalogMutex);
+    return catalog.at(index).state;
+}
+
+/**
+ * @brief Kurzer Text zum Zustand einer Karte für das Menü.
+ * @param index Index der Karte in der Liste der verfügbaren Karten
+ * @return z.B. "gültig, Par 27" oder "ungültig: Leiter ohne Ende (Zeile 5, Spalte 12)"
+ */
+std::string Map::getMapStatus(size_t index) const
+{
+    std::lock_guard<std::mutex> lock(catalogMutex);
+    const CatalogEntry& entry = catalog.at(index);
+
+    switch (entry.state)
+    {
+        case MapState::LOADING:
+            return "wird geprüft...";
+        case MapState::VALID:
+            if (entry.report.incremental && entry.report.changedRows > 0)
+            {
+                size_t rows = entry.report.changedRows;
+                return "gültig, Par " + std::to_string(entry.level->solution.size()) + ", geändert: "
+                       + std::to_string(rows) + (rows == 1 ? " Zeile, " : " Zeilen, ")
+                       + std::to_string(entry.report.checkedColumns) + " Spalten neu geprüft";
+            }
+            return "gültig, Par " + std::to_string(entry.level->solution.size()) + (entry.report.builtin ? ", eingebaut" : "");
+        case MapState::INVALID:
+            break;
+    }
+    return "ungültig: " + describeLoadError(entry.report);
+}
+
+/**
+ * @brief Beschreibt, warum eine Karte nicht geladen werden konnte, in einer Zeile.
  *
- * Eine Plattform ist dann korrekt platziert, wenn genügend freier Raum über ihr ist
- * und wenn sie korrekt in der Kartenstruktur positioniert ist.
+ * Zeilen und Spalten zählen wie im Editor ab 1, die Zeile mit den Abmessungen nicht mitgezählt.
  *
- * @param row Die Zeilenposition der Plattform, die überprüft werden soll.
- * @param col Die Spaltenposition der Plattform, die überprüft werden soll.
- * @return True, wenn die Plattform korrekt platziert ist, sonst False.
- * @pre Die Position sollte innerhalb der Grenzen der Karte sein
+ * @param report Ergebnis von Level::loadText()
  */
-bool Map::isPlatformValid(size_t row, size_t col) const
+std::string Map::describeLoadError(const LoadReport& report) const
 {
-    if (row < PLAYER_HEIGHT) return false;
+    auto position = [](size_t row, size_t col) {
+        return " (Zeile " + std::to_string(row + 1) + ", Spalte " + std::to_string(col + 1) + ")";
+    };
 
-    size_t freeSpace = height - row - 1; // berechnet, wie hoch man von unten steht;
-    size_t availableCheckRoom = MAX_SPACE;
+    const ValidationResult& result = report.validation;
 
-    if (freeSpace < MAX_SPACE)  //out of range exception handling
+    switch (report.status)
     {
-        availableCheckRoom = freeSpace;
+        case LoadReport::Status::OPEN_FAILED:
+            return "Datei konnte nicht geöffnet werden";
+        case LoadReport::Status::BAD_DIMENSION:
+            return "falsche Breite/Höhe";
+        case LoadReport::Status::UNREACHABLE:
+            return "Ziel ist nicht erreichbar";
+        case LoadReport::Status::OUT_OF_MEMORY:
+            return "zu groß für den Speicher";
+        case LoadReport::Status::OK:
+            return "";
+        case LoadReport::Status::INVALID:
+            break;
     }
 
-    //prüft MAX_SPACE untenstehende zellen
-    for(size_t check_row = row + 1; check_row <= row + availableCheckRoom; ++check_row)
+    switch (result.error)
     {
-        if (renderMap2D[check_row][col] == '-')
-        {
-            std::cout << "falsche ebene: " << check_row + 1 << "x" << col + 1 << std::endl;
-            return false;
-        }
+        case ValidationResult::Error::PLATFORM_ROW:
+            if (limitsOf(RULES).playerHeight > 1)
+            {
+                return "Plattform in den obersten " + std::to_string(limitsOf(RULES).playerHeight) + " Zeilen"
+                       + position(result.errorRow, result.errorCol);
+            }
+            return "Plattform in der obersten Zeile" + position(result.errorRow, result.errorCol);
+        case ValidationResult::Error::PLATFORM_SPACE:
+            return "Plattformen zu nah übereinander" + position(result.errorRow, result.errorCol);
+        case ValidationResult::Error::LADDER_START:
+            return "Leiter beginnt im leeren Raum" + position(result.errorRow, result.errorCol);
+        case ValidationResult::Error::LADDER_END:
+            return "Leiter endet nicht auf einer Plattform" + position(result.errorRow, result.errorCol);
+        case ValidationResult::Error::SYMBOL_GROUND:
+            return "S/O steht nicht auf einer Plattform" + position(result.errorRow, result.errorCol);
+        case ValidationResult::Error::MISSING_SYMBOL:
+            return "S oder O fehlt";
+        case ValidationResult::Error::NONE:
+            break;
     }
-    return true;
+    return "";
 }
 
 /**
- * @brief Prüft, ob Höhe und Breite richtig angegeben wurden
- * @param input input string
- * @pre input muss int sein
- * @return size_t dimension (width or height)
+ * @brief Gibt die Fehlermeldungen zu einer Karte aus, die nicht geladen werden konnte.
+ * @param report Ergebnis von Level::loadText()
  */
-size_t Map::setDimension(const std::string& input)
+void Map::reportLoadError(const LoadReport& report) const
 {
-    try
+    switch (report.status)
     {
-        int dimension = std::stoi(input);
-        if(dimension < 1)
-        {
-            std::cerr << "Breite/Höhe muss größer als 0 sein\n";
-            return 0;
-        }
-
-        return static_cast<size_t>(dimension);
-    }
-    catch (const std::invalid_argument&)
-    {
-        std::cerr << "Falsche Breite/Höhe\n";
-    }
-    catch (const std::out_of_range&)
-    {
-        std::cerr << "Breite/Höhe ist zu groß\n";
+        case LoadReport::Status::OPEN_FAILED:
+            std::cout << "Datei konnte nicht geöffnet werden\n";
+            break;
+        case LoadReport::Status::BAD_DIMENSION:
+            for (auto error : {report.heightError, report.widthError})
+            {
+                switch (error)
+                {
+                    case MapLoader::DimensionError::TOO_SMALL:
+                        std::cerr << "Breite/Höhe muss größer als 0 sein\n";
+                        break;
+                    case MapLoader::DimensionError::INVALID:
+                        std::cerr << "Falsche Breite/Höhe\n";
+                        break;
+                    case MapLoader::DimensionError::TOO_LARGE:
+                        std::cerr << "Breite/Höhe ist zu groß\n";
+                        break;
+                    case MapLoader::DimensionError::NONE:
+                        break;
+                }
+            }
+            break;
+        case LoadReport::Status::INVALID:
+            if (report.validation.error == ValidationResult::Error::PLATFORM_SPACE)
+            {
+                std::cout << "falsche ebene: " << report.validation.conflictRow + 1 << "x"
+                          << report.validation.errorCol + 1 << std::endl;
+            } else if (report.validation.error == ValidationResult::Error::LADDER_START)
+            {
+                std::cout << "falsche Leiter " << report.validation.errorRow + 2 << " x "
+                          << report.validation.errorCol + 1 << "\n";
+            }
+            std::cout << "Die hochgeladene Karte ist ungültig\n";
+            break;
+        case LoadReport::Status::UNREACHABLE:
+            std::cout << "Das Ziel ist vom Start aus nicht erreichbar\n";
+            std::cout << "Die hochgeladene Karte ist ungültig\n";
+            break;
+        case LoadReport::Status::OUT_OF_MEMORY:
+            std::cout << "Die Karte ist zu groß für den Speicher\n";
+            break;
+        case LoadReport::Status::OK:
+            break;
     }
+}
 
-    return 0;
+/**
+ * @brief Map getter
+ *
+ * Gibt einen geteilten, unveränderlichen Schnappschuss der geladenen Karte zurück.
+ * Eine geladene Karte wird nie mehr verändert, selectMap() legt immer eine neue an.
+ */
+std::shared_ptr<const Grid> Map::getMap() const
+{
+    return level ? std::shared_ptr<const Grid>(level, &level->grid) : nullptr;
 }
 
-///@brief Map getter
-const std::vector<std::vector<char>>& Map::getMap() const
+/**
+ * @brief Level getter: Karte, Plattformindex, Start- und Zielposition
+ *
+ * Unveränderlich und geteilt wie getMap().
+ */
+std::shared_ptr<const Level> Map::getLevel() const
 {
-    return renderMap2D;
+    return level;
 }
 
 ///@brief Anfangsposition getter
@@ -361,3 +611,9 @@ const std::vector<std::string>& Map::getMapsNames() const
 {
     return availableMaps;
 }
+
+///@brief Dateiname der ausgewählten Karte, z.B. für Aufzeichnungen
+const std::string& Map::getMapName() const
+{
+    return mapName;
+}
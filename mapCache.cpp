@@ -0,0 +1,234 @@
+#include "headers/mapCache.h"
+#include "headers/mappedFile.h"
+#include "headers/profiler.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sys/stat.h>
+
+namespace {
+
+const char MAGIC[4] = {'A', 'M', 'A', 'P'};
+const uint32_t VERSION = 4;
+
+/**
+ * Kopf einer .amap-Datei. Danach folgen height x width Zellen (Zeile für Zeile, ohne
+ * Padding) und die solutionLength Zeichen der kürzesten Lösung.
+ */
+struct Header {
+    char magic[4];
+    uint32_t version;
+    uint64_t sourceSize;
+    int64_t sourceMtime; ///< Nanosekunden
+    uint64_t sourceHash;
+    uint64_t rules; ///< RuleProfile
+    uint64_t height, width;
+    uint64_t startRow, startCol, goalRow, goalCol;
+    uint64_t solutionLength;
+};
+
+///@brief Größe und Änderungszeit der Quelldatei
+bool sourceInfo(const std::string& path, uint64_t& size, int64_t& mtime)
+{
+    struct stat info{};
+    if (stat(path.c_str(), &info) != 0) return false;
+
+    size = static_cast<uint64_t>(info.st_size);
+    mtime = static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+    return true;
+}
+
+/**
+ * @brief Prüft, dass keine Plattform in den obersten playerHeight Zeilen liegt.
+ *
+ * Das hat MapValidator beim Schreiben geprüft, die Übergangstabelle stellt den Spieler
+ * über jede Plattform und verlässt sich darauf. Die Zeilen jeder Spalte sind aufsteigend,
+ * es reicht also die erste.
+ */
+bool platformsBelowTop(const PlatformIndex& platforms, size_t playerHeight)
+{
+    const auto& offsets = platforms.getOffsets();
+    const auto& rows = platforms.getRows();
+
+    for (size_t col = 0; col + 1 < offsets.size(); ++col)
+    {
+        if (offsets[col] < offsets[col + 1] && rows[offsets[col]] < playerHeight) return false;
+    }
+    return true;
+}
+
+///@brief Hash des Inhalts der Quelldatei, 0 wenn sie nicht gelesen werden kann
+uint64_t sourceHash(const std::string& path)
+{
+    MappedFile source(path);
+    return source.isOpen() ? MapCache::contentHash(source.data(), source.size()) : 0;
+}
+
+}
+
+/**
+ * @brief Pfad der .amap-Datei zu einer Karte: gleiche Stelle, Endung .amap.
+ */
+std::string MapCache::cachePath(const std::string& sourcePath)
+{
+    size_t dot = sourcePath.rfind('.');
+    size_t slash = sourcePath.rfind('/');
+
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+    {
+        return sourcePath + ".amap";
+    }
+    return sourcePath.substr(0, dot) + ".amap";
+}
+
+/**
+ * @brief Lädt eine Karte aus ihrer .amap-Datei, ohne sie erneut zu prüfen.
+ *
+ * Die .amap-Datei wird einmal eingeblendet und in die Karte kopiert. Plattformindex
+ * und Übergangstabelle werden nicht gespeichert, sondern aus den Zellen berechnet, so
+ * kann ein beschädigter Index nicht von der Karte abweichen. Passt der Inhalt nicht
+ * zusammen (Größen, Plattform in den obersten Zeilen, Start und Ziel), wird die Datei
+ * verworfen, der Aufrufer liest dann die .txt-Datei. level bleibt in dem Fall
+ * unverändert.
+ *
+ * @param sourcePath Pfad der .txt-Datei
+ * @param level wird gefüllt, wenn die .amap-Datei aktuell ist
+ * @param rules Regelprofil, mit dem die Karte geprüft sein muss
+ * @return True, wenn eine aktuelle .amap-Datei geladen wurde
+ */
+bool MapCache::load(const std::string& sourcePath, Level& level, RuleProfile rules)
+{
+    PROFILE_SCOPE("cache.load");
+
+    uint64_t size = 0;
+    int64_t mtime = 0;
+    if (!sourceInfo(sourcePath, size, mtime)) return false;
+
+    MappedFile cache(cachePath(sourcePath));
+    if (!cache.isOpen() || cache.size() < sizeof(Header)) return false;
+
+    Header header{};
+    std::memcpy(&header, cache.data(), sizeof(Header));
+
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION
+        || header.rules != static_cast<uint64_t>(rules) || header.sourceSize != size)
+    {
+        return false;
+    }
+
+    //nur die Zeit ist anders (z.B. Datei ohne Änderung gespeichert): Inhalt vergleichen
+    if (header.sourceMtime != mtime && header.sourceHash != sourceHash(sourcePath))
+    {
+        return false;
+    }
+
+    //der Kopf kann beschädigt sein: erst die Größen begrenzen, dann rechnen, ohne dass etwas überläuft
+    if (header.height == 0 || header.width == 0 || header.width > Level::MAX_CELLS / header.height) return false;
+
+    uint64_t cells = header.height * header.width;
+    if (header.solutionLength > cache.size() || cache.size() != sizeof(Header) + cells + header.solutionLength)
+    {
+        return false;
+    }
+
+    if (header.startRow >= header.height || header.startCol >= header.width
+        || header.goalRow >= header.height || header.goalCol >= header.width)
+    {
+        return false;
+    }
+
+    const char* data = cache.data() + sizeof(Header);
+
+    Grid grid(header.height, header.width, ' ');
+    for (size_t row = 0; row < header.height; ++row)
+    {
+        std::memcpy(grid.row(row), data + row * header.width, header.width);
+    }
+    data += cells;
+
+    PlatformIndex platforms;
+    platforms.build(grid);
+    if (!platformsBelowTop(platforms, limitsOf(rules).playerHeight)) return false;
+
+    level.grid = std::move(grid);
+    level.rules = rules;
+    level.platforms = std::move(platforms);
+    level.startPos = {header.startRow, header.startCol};
+    level.goalPos = {header.goalRow, header.goalCol};
+    level.solution.assign(data, header.solutionLength);
+    Level::buildTransitions(level);
+
+    return true;
+}
+
+/**
+ * @brief Schreibt eine gültige Karte als .amap-Datei neben die .txt-Datei.
+ *
+ * Es wird zuerst in eine temporäre Datei geschrieben und diese dann umbenannt,
+ * damit nie eine halbe .amap-Datei gelesen wird. Ist der Ordner nicht beschreibbar,
+ * passiert nichts.
+ *
+ * @param sourcePath Pfad der .txt-Datei
+ * @param level die geladene und geprüfte Karte, mit ihrem Regelprofil
+ * @return True, wenn die Datei geschrieben wurde
+ */
+bool MapCache::store(const std::string& sourcePath, const Level& level)
+{
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+
+    if (!sourceInfo(sourcePath, header.sourceSize, header.sourceMtime)) return false;
+
+    header.sourceHash = sourceHash(sourcePath);
+    header.rules = static_cast<uint64_t>(level.rules);
+    header.height = level.grid.getHeight();
+    header.width = level.grid.getWidth();
+    header.startRow = level.startPos[0];
+    header.startCol = level.startPos[1];
+    header.goalRow = level.goalPos[0];
+    header.goalCol = level.goalPos[1];
+    header.solutionLength = level.solution.size();
+
+    std::string path = cachePath(sourcePath);
+    std::string temporary = path + ".tmp";
+
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        for (size_t row = 0; row < level.grid.getHeight(); ++row)
+        {
+            out.write(level.grid.row(row), static_cast<std::streamsize>(level.grid.getWidth()));
+        }
+
+        out.write(level.solution.data(), static_cast<std::streamsize>(level.solution.size()));
+
+        if (!out)
+        {
+            out.close();
+            std::remove(temporary.c_str());
+            return false;
+        }
+    }
+
+    return std::rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+/**
+ * @brief 64-Bit FNV-1a Hash über den Dateiinhalt.
+ * @param seed Startwert, z.B. der Hash der vorherigen Teile, um mehrere Teile zu verketten
+ */
+uint64_t MapCache::contentHash(const char* data, size_t size, uint64_t seed)
+{
+    uint64_t hash = seed;
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ull;
+    }
+
+    return hash;
+}
@@ -0,0 +1,197 @@
+#include "headers/mapGenerator.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * SplitMix64: schnell und auf jeder Plattform gleich, anders als die
+ * Verteilungen aus <random>.
+ */
+class Random {
+public:
+    explicit Random(uint64_t seed): state(seed) {}
+
+    uint64_t next()
+    {
+        uint64_t value = (state += 0x9E3779B97F4A7C15ull);
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+        return value ^ (value >> 31);
+    }
+
+    ///@brief Zahl in [0, bound)
+    size_t below(size_t bound)
+    {
+        return static_cast<size_t>(next() % bound);
+    }
+
+private:
+    uint64_t state;
+};
+
+/**
+ * @brief Würfelt die Lücken einer Ebene.
+ * @param above die Ebene darüber oder nullptr; unter deren Lücken bleibt die Ebene fest
+ * @param solid Ergebnis, true für '-'
+ */
+void rollLayer(Random& random, uint64_t threshold, const std::vector<char>* above, std::vector<char>& solid)
+{
+    for (size_t col = 0; col < solid.size(); ++col)
+    {
+        bool gapAbove = above != nullptr && !(*above)[col];
+        solid[col] = gapAbove || (random.next() >> 32) < threshold;
+    }
+}
+
+void writeRow(std::ostream& out, const std::string& line)
+{
+    out.write(line.data(), static_cast<std::streamsize>(line.size()));
+    out.put('\n');
+}
+
+}
+
+/**
+ * @brief Prüft, ob mit den Einstellungen eine gültige Karte möglich ist.
+ *
+ * Nötig sind mindestens zwei Ebenen (Start und Boden), zwei Zeilen über der
+ * obersten Ebene für S und mindestens 2 Spalten.
+ */
+bool MapGenerator::optionsValid(const GeneratorOptions& options)
+{
+    return (options.spacing == 4 || options.spacing == 5) && options.width >= 2
+           && options.height >= 3 + options.spacing && options.density >= 0 && options.density <= 1;
+}
+
+/**
+ * @brief Schreibt eine Karte im Textformat der maps/-Dateien.
+ *
+ * @param out Ziel, z.B. eine std::ofstream
+ * @param options Größe, Seed, Dichte, Leitern
+ * @return false, wenn die Einstellungen ungültig sind oder das Schreiben fehlschlägt
+ */
+bool MapGenerator::write(std::ostream& out, const GeneratorOptions& options)
+{
+    if (!optionsValid(options)) return false;
+
+    const size_t width = options.width, height = options.height, spacing = options.spacing;
+    const size_t FIRST_ROW = 2; //Zeile 0: S, Zeile 1: Spieler
+    const size_t layers = (height - 1 - FIRST_ROW) / spacing + 1;
+    const auto threshold = static_cast<uint64_t>(options.density * 4294967296.0);
+
+    Random random(options.seed);
+
+    std::vector<char> current(width), next(width), arriving(width, 0);
+    std::vector<size_t> eligible;
+    std::string line(width, ' ');
+
+    out << height << " " << width << "\n";
+
+    rollLayer(random, threshold, nullptr, current);
+
+    //S steht auf der obersten Ebene
+    size_t startCol = random.below(width);
+    current[startCol] = 1;
+
+    line.assign(width, ' ');
+    line[startCol] = 'S';
+    writeRow(out, line);
+    writeRow(out, std::string(width, ' '));
+
+    size_t row = FIRST_ROW;
+    for (size_t layer = 0; layer < layers; ++layer)
+    {
+        bool floor = layer + 1 == layers;
+
+        std::vector<size_t> ladders;
+        if (!floor)
+        {
+            if (layer + 2 == layers)
+            {
+                std::fill(next.begin(), next.end(), 1); //der Boden hat keine Lücken
+            } else {
+                rollLayer(random, threshold, &current, next);
+            }
+
+            //wo eine Leiter von oben ankommt, führt 'F' immer nach oben: dort keine Leiter nach unten
+            eligible.clear();
+            for (size_t col = 0; col < width; ++col)
+            {
+                if (current[col] && next[col] && !arriving[col]) eligible.push_back(col);
+            }
+
+            //keine passende Spalte: eine erzwingen, feste Zellen verletzen keine Regel
+            if (eligible.empty())
+            {
+                size_t col = random.below(width);
+                while (arriving[col]) col = (col + 1) % width;
+
+                current[col] = next[col] = 1;
+                eligible.push_back(col);
+            }
+
+            //höchstens halb so viele wie Spalten, damit für die nächste Ebene Spalten frei bleiben
+            size_t count = std::min({std::max<size_t>(options.laddersPerLayer, 1), std::max<size_t>(width / 2, 1),
+                                     eligible.size()});
+            for (size_t i = 0; i < count; ++i) //die ersten count Spalten einer Zufallsauswahl
+            {
+                std::swap(eligible[i], eligible[i + random.below(eligible.size() - i)]);
+                ladders.push_back(eligible[i]);
+            }
+        }
+
+        for (size_t col = 0; col < width; ++col)
+        {
+            line[col] = current[col] ? '-' : ' ';
+        }
+        writeRow(out, line);
+        ++row;
+
+        if (floor)
+        {
+            break;
+        }
+
+        line.assign(width, ' ');
+        for (size_t col : ladders)
+        {
+            line[col] = 'H';
+        }
+        for (size_t i = 1; i < spacing; ++i, ++row)
+        {
+            //O steht zwei Zeilen über dem Boden
+            if (layer + 2 == layers && i == spacing - 2)
+            {
+                std::string goalLine = line;
+                size_t goalCol = random.below(width);
+                for (size_t tries = 0; tries < width && goalLine[goalCol] == 'H'; ++tries)
+                {
+                    goalCol = (goalCol + 1) % width; //nicht mitten in eine Leiter
+                }
+                goalLine[goalCol] = 'O';
+                writeRow(out, goalLine);
+                continue;
+            }
+            writeRow(out, line);
+        }
+
+        std::fill(arriving.begin(), arriving.end(), 0);
+        for (size_t col : ladders)
+        {
+            arriving[col] = 1;
+        }
+
+        current.swap(next);
+    }
+
+    //Zeilen unter dem Boden bleiben leer
+    line.assign(width, ' ');
+    for (; row < height; ++row)
+    {
+        writeRow(out, line);
+    }
+
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,195 @@
+#include "headers/mapLoader.h"
+#include "headers/profiler.h"
+#include <algorithm>
+#include <charconv>
+#include <climits>
+#include <cstring>
+
+/**
+ * @brief Liefert die erste Zeile (Höhe und Breite) als Sicht auf den Dateiinhalt.
+ * @param data Dateiinhalt
+ * @param size Größe des Dateiinhalts
+ * @param bodyOffset erhält den Anfang der zweiten Zeile
+ * @return die erste Zeile ohne Zeilenende
+ */
+std::string_view MapLoader::headerLine(const char* data, size_t size, size_t& bodyOffset)
+{
+    if (size == 0)
+    {
+        bodyOffset = 0;
+        return {};
+    }
+
+    const auto* newline = static_cast<const char*>(std::memchr(data, '\n', size));
+    size_t length = (newline == nullptr) ? size : static_cast<size_t>(newline - data);
+
+    bodyOffset = (newline == nullptr) ? size : length + 1;
+    return {data, length};
+}
+
+/**
+ * @brief Liest eine Höhe oder Breite, wie std::stoi, aber ohne Ausnahmen und ohne Kopie.
+ *
+ * Führende Leerzeichen und ein Vorzeichen sind erlaubt, danach zählen alle Ziffern
+ * bis zum ersten anderen Zeichen.
+ *
+ * @param input Text mit der Zahl
+ * @param dimension erhält die Zahl, wenn kein Fehler auftritt
+ * @return NONE, TOO_SMALL (kleiner als 1), INVALID (keine Zahl) oder TOO_LARGE (größer als int)
+ */
+MapLoader::DimensionError MapLoader::parseDimension(std::string_view input, size_t& dimension)
+{
+    size_t pos = 0;
+    while (pos < input.size() && (input[pos] == ' ' || (input[pos] >= '\t' && input[pos] <= '\r')))
+    {
+        ++pos;
+    }
+
+    bool negative = false;
+    if (pos < input.size() && (input[pos] == '+' || input[pos] == '-'))
+    {
+        negative = input[pos] == '-';
+        ++pos;
+    }
+
+    if (pos >= input.size() || input[pos] < '0' || input[pos] > '9')
+    {
+        return DimensionError::INVALID;
+    }
+
+    long long value = 0;
+    auto parsed = std::from_chars(input.data() + pos, input.data() + input.size(), value);
+
+    if (parsed.ec == std::errc::result_out_of_range)
+    {
+        return DimensionError::TOO_LARGE;
+    }
+
+    value = negative ? -value : value;
+
+    if (value > INT_MAX || value < INT_MIN)
+    {
+        return DimensionError::TOO_LARGE;
+    }
+    if (value < 1)
+    {
+        return DimensionError::TOO_SMALL;
+    }
+
+    dimension = static_cast<size_t>(value);
+    return DimensionError::NONE;
+}
+
+/**
+ * @brief Übernimmt die Kartenzeilen in die Karte.
+ *
+ * Zu kurze Zeilen bleiben mit Leerzeichen aufgefüllt, zu lange werden abgeschnitten.
+ * Zeilen nach der letzten Kartenzeile werden ignoriert.
+ *
+ * @param data Anfang der ersten Kartenzeile
+ * @param size Anzahl Bytes bis zum Dateiende
+ * @param grid die Karte, alle Zellen müssen Leerzeichen sein
+ * @return Anzahl der übernommenen Zeilen
+ */
+size_t MapLoader::copyRows(const char* data, size_t size, Grid& grid)
+{
+    PROFILE_SCOPE("level.parse");
+
+    const char* end = data + size;
+    size_t width = grid.getWidth();
+    size_t row = 0;
+
+    while (data < end && row < grid.getHeight())
+    {
+        const auto* newline = static_cast<const char*>(std::memchr(data, '\n', static_cast<size_t>(end - data)));
+        const char* lineEnd = (newline == nullptr) ? end : newline;
+        auto length = static_cast<size_t>(lineEnd - data);
+
+        std::memcpy(grid.row(row), data, length < width ? length : width);
+
+        data = (newline == nullptr) ? end : newline + 1;
+        ++row;
+    }
+
+    return row;
+}
+
+/**
+ * @brief Überspringt Kartenzeilen, z.B. um eine große Karte in Streifen zu lesen.
+ *
+ * @param data Anfang einer Kartenzeile
+ * @param size Anzahl Bytes bis zum Dateiende
+ * @param count so viele Zeilen überspringen
+ * @return Anzahl Bytes bis zum Anfang der Zeile danach, höchstens size
+ */
+size_t MapLoader::skipRows(const char* data, size_t size, size_t count)
+{
+    const char* begin = data;
+    const char* end = data + size;
+
+    for (size_t row = 0; row < count && data < end; ++row)
+    {
+        const auto* newline = static_cast<const char*>(std::memchr(data, '\n', static_cast<size_t>(end - data)));
+        data = (newline == nullptr) ? end : newline + 1;
+    }
+
+    return static_cast<size_t>(data - begin);
+}
+
+/**
+ * @brief Übernimmt die Kartenzeilen in eine Karte, die schon die vorherige Fassung enthält.
+ *
+ * Jede Zeile wird mit der vorherigen verglichen, nur geänderte Zeilen werden kopiert.
+ * Für jeden Block zu Grid::ALIGNMENT Spalten wird vermerkt, ob sich darin etwas
+ * geändert hat. Fehlende Zeilen am Dateiende zählen wie beim Laden als Leerzeichen.
+ *
+ * @param data Anfang der ersten Kartenzeile
+ * @param size Anzahl Bytes bis zum Dateiende
+ * @param grid die vorherige, unbereinigte Fassung mit gleicher Höhe und Breite, wird aktualisiert
+ * @param dirtyBlocks wird auf einen Eintrag pro Block gesetzt, 1 für einen geänderten Block
+ * @return Anzahl der geänderten Zeilen
+ */
+size_t MapLoader::updateRows(const char* data, size_t size, Grid& grid, std::vector<uint8_t>& dirtyBlocks)
+{
+    PROFILE_SCOPE("level.parse");
+
+    const char* end = data + size;
+    size_t width = grid.getWidth();
+    size_t stride = grid.getStride();
+    size_t changed = 0;
+
+    dirtyBlocks.assign(stride / Grid::ALIGNMENT, 0);
+    std::vector<char> line(stride);
+
+    for (size_t row = 0; row < grid.getHeight(); ++row)
+    {
+        std::fill(line.begin(), line.end(), ' ');
+
+        if (data < end)
+        {
+            const auto* newline = static_cast<const char*>(std::memchr(data, '\n', static_cast<size_t>(end - data)));
+            const char* lineEnd = (newline == nullptr) ? end : newline;
+            auto length = static_cast<size_t>(lineEnd - data);
+
+            std::memcpy(line.data(), data, length < width ? length : width);
+            data = (newline == nullptr) ? end : newline + 1;
+        }
+
+        char* current = grid.row(row);
+        if (std::memcmp(line.data(), current, stride) == 0) continue;
+
+        for (size_t block = 0; block < dirtyBlocks.size(); ++block)
+        {
+            size_t offset = block * Grid::ALIGNMENT;
+            if (std::memcmp(line.data() + offset, current + offset, Grid::ALIGNMENT) != 0)
+            {
+                dirtyBlocks[block] = 1;
+            }
+        }
+
+        std::memcpy(current, line.data(), stride);
+        ++changed;
+    }
+
+    return changed;
+}
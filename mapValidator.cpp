@@ -0,0 +1,391 @@
+#include "headers/mapValidator.h"
+#include "headers/profiler.h"
+#include <algorithm>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+///@brief True, wenn kein Fehler gefunden wurde
+bool ValidationResult::ok() const
+{
+    return error == Error::NONE;
+}
+
+/**
+ * @brief Merkt sich einen Fehler, wenn er in Zeilenreihenfolge vor dem bisherigen liegt.
+ * @param kind Art des Fehlers
+ * @param row Zeile der fehlerhaften Zelle
+ * @param col Spalte der fehlerhaften Zelle
+ * @param conflict bei PLATFORM_SPACE die Zeile der Plattform darunter
+ */
+void ValidationResult::recordError(Error kind, size_t row, size_t col, size_t conflict)
+{
+    if (error == Error::NONE || row < errorRow || (row == errorRow && col < errorCol))
+    {
+        error = kind;
+        errorRow = row;
+        errorCol = col;
+        conflictRow = conflict;
+    }
+}
+
+///@brief Merkt sich das S-Symbol, das letzte in Zeilenreihenfolge gewinnt
+void ValidationResult::recordStart(size_t row, size_t col)
+{
+    if (startRow == NO_POS || row > startRow || (row == startRow && col > startCol))
+    {
+        startRow = row;
+        startCol = col;
+    }
+}
+
+///@brief Merkt sich das O-Symbol, das letzte in Zeilenreihenfolge gewinnt
+void ValidationResult::recordGoal(size_t row, size_t col)
+{
+    if (goalRow == NO_POS || row > goalRow || (row == goalRow && col > goalCol))
+    {
+        goalRow = row;
+        goalCol = col;
+    }
+}
+
+/**
+ * @brief Führt das Ergebnis eines anderen Spaltenbereichs mit diesem zusammen.
+ *
+ * Das Ergebnis hängt nicht von der Reihenfolge der Aufrufe ab.
+ */
+void ValidationResult::merge(const ValidationResult& other)
+{
+    if (!other.ok())
+    {
+        recordError(other.error, other.errorRow, other.errorCol, other.conflictRow);
+    }
+    if (other.startRow != NO_POS)
+    {
+        recordStart(other.startRow, other.startCol);
+    }
+    if (other.goalRow != NO_POS)
+    {
+        recordGoal(other.goalRow, other.goalCol);
+    }
+}
+
+/**
+ * @brief Konstruktor, legt den Spaltenzustand für die Spalten [first, last) an.
+ * @param first erste Spalte, Vielfaches von Grid::ALIGNMENT
+ * @param last Spalte hinter der letzten, wird auf ein Vielfaches von 16 aufgerundet
+ * @param maxSpace freie Zeilen, die unter einer Plattform nötig sind
+ * @param playerHeight Höhe des Spielers, so viele Zeilen oben dürfen keine Plattform haben
+ */
+MapValidator::MapValidator(size_t first, size_t last, size_t maxSpace, size_t playerHeight)
+        : firstCol(first), lastCol((last + CHUNK - 1) / CHUNK * CHUNK),
+          MAX_SPACE(maxSpace), PLAYER_HEIGHT(playerHeight)
+{
+    size_t columns = lastCol - firstCol;
+
+    lastPlatform.assign(columns, NONE);
+    pendingLadder.assign(columns, NONE);
+    pendingPerChunk.assign(columns / CHUNK, 0);
+}
+
+/**
+ * @brief Prüft eine Zeile und ersetzt bedeutungslose Zeichen durch Leerzeichen.
+ *
+ * Pro Block von 16 Zellen wird zuerst bestimmt, wo '-', 'H', 'S' und 'O' stehen.
+ * Ist in dem Block keine Leiter offen, werden nur diese Zellen einzeln angeschaut,
+ * reine Leerblöcke kosten also nur einen Vergleich.
+ *
+ * @param row Zeilennummer
+ * @param above die schon bereinigte Zeile darüber, nullptr für die erste Zeile
+ * @param current die aktuelle Zeile, wird bereinigt
+ * @param below2 die Zeile zwei Einträge darunter (unverändert), nullptr wenn es sie nicht gibt
+ * @pre Die Zeilen sind mindestens bis zum aufgerundeten lastCol lesbar (STRIDE)
+ */
+void MapValidator::consumeRow(size_t row, const char* above, char* current, const char* below2)
+{
+    for (size_t base = firstCol; base < lastCol; base += CHUNK)
+    {
+        char* cells = current + base;
+
+#if defined(__SSE2__)
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cells));
+        __m128i keep = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8('-')),
+                                                 _mm_cmpeq_epi8(block, _mm_set1_epi8('H'))),
+                                    _mm_cmpeq_epi8(block, _mm_set1_epi8('O')));
+        __m128i start = _mm_cmpeq_epi8(block, _mm_set1_epi8('S'));
+        auto interesting = static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(keep, start)));
+#else
+        uint32_t interesting = 0;
+        for (size_t i = 0; i < CHUNK; ++i)
+        {
+            char cell = cells[i];
+            if (cell == '-' || cell == 'H' || cell == 'S' || cell == 'O')
+            {
+                interesting |= 1u << i;
+            }
+        }
+#endif
+
+        //offene Leiter im Block: auch Leerzeichen sind wichtig, dann alle Zellen anschauen
+        uint32_t visit = pendingPerChunk[(base - firstCol) / CHUNK] != 0 ? 0xFFFFu : interesting;
+
+        while (visit != 0)
+        {
+            auto bit = static_cast<size_t>(__builtin_ctz(visit));
+            visit &= visit - 1;
+            visitCell(row, base + bit, cells[bit], above, below2);
+        }
+
+#if defined(__SSE2__)
+        __m128i blanked = _mm_or_si128(_mm_and_si128(keep, block), _mm_andnot_si128(keep, _mm_set1_epi8(' ')));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(cells), blanked);
+#else
+        for (size_t i = 0; i < CHUNK; ++i)
+        {
+            char cell = cells[i];
+            if (cell != '-' && cell != 'H' && cell != 'O')
+            {
+                cells[i] = ' ';
+            }
+        }
+#endif
+    }
+}
+
+/**
+ * @brief Wendet die Regeln auf eine Zelle an und aktualisiert den Spaltenzustand.
+ *
+ * - '-': keine Plattform in den obersten PLAYER_HEIGHT Zeilen und höchstens eine
+ *   Plattform in MAX_SPACE Zeilen (der Fehler gehört zur oberen Plattform)
+ * - 'H': darüber muss '-', 'H' oder 'O' stehen, die Leiter muss auf '-' enden
+ *   und darf nicht im leeren Raum oder am Kartenende aufhören
+ * - 'S'/'O': zwei Einträge darunter muss eine Plattform sein
+ */
+void MapValidator::visitCell(size_t row, size_t col, char cell, const char* above, const char* below2)
+{
+    size_t index = col - firstCol;
+    size_t& pending = pendingLadder[index];
+
+    switch (cell)
+    {
+        case '-':
+        {
+            if (row < PLAYER_HEIGHT)
+            {
+                result.recordError(ValidationResult::Error::PLATFORM_ROW, row, col);
+            }
+
+            size_t& last = lastPlatform[index];
+            if (last != NONE && row - last <= MAX_SPACE)
+            {
+                result.recordError(ValidationResult::Error::PLATFORM_SPACE, last, col, row);
+            }
+            last = row;
+
+            if (pending != NONE) //Leiter endet auf einer Plattform
+            {
+                pending = NONE;
+                --pendingPerChunk[index / CHUNK];
+            }
+            break;
+        }
+        case ' ':
+            if (pending != NONE) //Leiter endet im leeren Raum
+            {
+                result.recordError(ValidationResult::Error::LADDER_END, pending, col);
+                pending = NONE;
+                --pendingPerChunk[index / CHUNK];
+            }
+            break;
+        case 'H':
+        {
+            char top = (above == nullptr) ? ' ' : above[col];
+            if (top != '-' && top != 'H' && top != 'O')
+            {
+                result.recordError(ValidationResult::Error::LADDER_START, row, col);
+            } else if (pending == NONE)
+            {
+                pending = row;
+                ++pendingPerChunk[index / CHUNK];
+            }
+            break;
+        }
+        case 'S':
+        case 'O':
+            if (below2 == nullptr || below2[col] != '-')
+            {
+                result.recordError(ValidationResult::Error::SYMBOL_GROUND, row, col);
+            }
+
+            if (cell == 'S')
+            {
+                result.recordStart(row, col);
+            } else {
+                result.recordGoal(row, col);
+            }
+            break;
+        default: //andere Zeichen unterbrechen eine Leiter nicht
+            break;
+    }
+}
+
+/**
+ * @brief Schließt die Prüfung ab: Leitern, die bis zum Kartenende offen sind, sind ungültig.
+ * @return Ergebnis für den Spaltenbereich dieses Validators
+ */
+ValidationResult MapValidator::finish()
+{
+    for (size_t index = 0; index < pendingLadder.size(); ++index)
+    {
+        if (pendingLadder[index] != NONE)
+        {
+            result.recordError(ValidationResult::Error::LADDER_END, pendingLadder[index], firstCol + index);
+            pendingLadder[index] = NONE;
+        }
+    }
+    std::fill(pendingPerChunk.begin(), pendingPerChunk.end(), 0);
+
+    return result;
+}
+
+/**
+ * @brief Prüft und bereinigt eine ganze Karte.
+ *
+ * Mit einem ThreadPool wird die Karte in Spaltenbänder zerlegt, jedes Band wird
+ * von einem eigenen Validator von oben nach unten geprüft. Die Ergebnisse werden
+ * danach zusammengeführt: erster Fehler nach (Zeile, Spalte), letztes S und O.
+ * Das Ergebnis ist also unabhängig von der Anzahl der Threads.
+ *
+ * @param grid die Karte, wird bereinigt
+ * @param maxSpace freie Zeilen, die unter einer Plattform nötig sind
+ * @param playerHeight Höhe des Spielers
+ * @param pool Threads für die parallele Prüfung, nullptr für eine Prüfung im aufrufenden Thread
+ * @return Ergebnis; MISSING_SYMBOL, wenn sonst alles stimmt, aber S oder O fehlt
+ */
+ValidationResult MapValidator::validate(Grid& grid, size_t maxSpace, size_t playerHeight, ThreadPool* pool)
+{
+    PROFILE_SCOPE("level.validate");
+
+    size_t stride = grid.getStride();
+
+    size_t bands = 1;
+    if (pool != nullptr)
+    {
+        bands = std::min(pool->size() + 1, stride / MIN_BAND_WIDTH);
+        bands = std::max<size_t>(bands, 1);
+    }
+
+    //Bandgrenzen auf Blöcke ausrichten, damit sich zwei Bänder nie einen Block teilen
+    size_t chunks = stride / CHUNK;
+    std::vector<ValidationResult> results(bands);
+
+    auto validateBand = [&](size_t band) {
+        size_t firstCol = chunks * band / bands * CHUNK;
+        size_t lastCol = chunks * (band + 1) / bands * CHUNK;
+
+        results[band] = validateColumns(grid, firstCol, lastCol, maxSpace, playerHeight);
+    };
+
+    if (bands == 1)
+    {
+        validateBand(0);
+    } else {
+        pool->parallelFor(bands, validateBand);
+    }
+
+    ValidationResult result;
+    for (const auto& bandResult : results)
+    {
+        result.merge(bandResult);
+    }
+
+    if (result.ok() && (result.startRow == ValidationResult::NO_POS || result.goalRow == ValidationResult::NO_POS))
+    {
+        result.recordError(ValidationResult::Error::MISSING_SYMBOL, 0, 0);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Prüft nur die geänderten Spaltenblöcke einer Karte erneut.
+ *
+ * Für eine Karte, deren vorherige Fassung gültig war: Da jede Regel nur von einer
+ * Spalte abhängt, gilt das alte Ergebnis für alle unveränderten Spalten weiter.
+ * Zusammenhängende geänderte Blöcke werden je von einem Validator geprüft, mit einem
+ * ThreadPool parallel. Der Aufwand ist also Höhe x geänderte Spalten.
+ *
+ * S und O aus den unveränderten Spalten kennt das Ergebnis nicht, der Aufrufer muss sie
+ * ergänzen (ValidationResult::recordStart/recordGoal) und danach fehlende Symbole prüfen.
+ *
+ * @param grid die Karte: in den geänderten Blöcken die neue, unbereinigte Fassung, sonst
+ *             die schon bereinigte; die geänderten Blöcke werden bereinigt
+ * @param dirtyBlocks pro Block zu Grid::ALIGNMENT Spalten ungleich 0, wenn er neu zu prüfen ist
+ * @param maxSpace freie Zeilen, die unter einer Plattform nötig sind
+ * @param playerHeight Höhe des Spielers
+ * @param pool Threads für die parallele Prüfung oder nullptr
+ * @return Ergebnis für die geänderten Spalten
+ */
+ValidationResult MapValidator::revalidate(Grid& grid, const std::vector<uint8_t>& dirtyBlocks, size_t maxSpace,
+                                          size_t playerHeight, ThreadPool* pool)
+{
+    PROFILE_SCOPE("level.validate");
+
+    static_assert(CHUNK == Grid::ALIGNMENT, "ein geänderter Block ist ein Block des Validators");
+
+    //zusammenhängende geänderte Blöcke als Spaltenbereiche
+    std::vector<std::pair<size_t, size_t>> ranges;
+    for (size_t block = 0; block < dirtyBlocks.size(); ++block)
+    {
+        if (dirtyBlocks[block] == 0) continue;
+
+        if (!ranges.empty() && ranges.back().second == block * CHUNK)
+        {
+            ranges.back().second += CHUNK;
+        } else {
+            ranges.emplace_back(block * CHUNK, (block + 1) * CHUNK);
+        }
+    }
+
+    std::vector<ValidationResult> results(ranges.size());
+    auto validateRange = [&](size_t index) {
+        results[index] = validateColumns(grid, ranges[index].first, ranges[index].second, maxSpace, playerHeight);
+    };
+
+    if (pool == nullptr || ranges.size() < 2)
+    {
+        for (size_t index = 0; index < ranges.size(); ++index) validateRange(index);
+    } else {
+        pool->parallelFor(ranges.size(), validateRange);
+    }
+
+    ValidationResult result;
+    for (const auto& rangeResult : results)
+    {
+        result.merge(rangeResult);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Prüft die Spalten [firstCol, lastCol) einer Karte von oben nach unten.
+ */
+ValidationResult MapValidator::validateColumns(Grid& grid, size_t firstCol, size_t lastCol, size_t maxSpace,
+                                               size_t playerHeight)
+{
+    size_t height = grid.getHeight();
+    MapValidator validator(firstCol, lastCol, maxSpace, playerHeight);
+
+    for (size_t row = 0; row < height; ++row)
+    {
+        validator.consumeRow(row,
+                             row > 0 ? grid.row(row - 1) : nullptr,
+                             grid.row(row),
+                             row + 2 < height ? grid.row(row + 2) : nullptr);
+    }
+
+    return validator.finish();
+}
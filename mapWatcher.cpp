@@ -0,0 +1,79 @@
+#include "headers/mapWatcher.h"
+#include <sys/inotify.h>
+#include <unistd.h>
+
+/**
+ * @brief Beginnt, den Ordner zu beobachten.
+ * @param directory z.B. "maps/"
+ */
+MapWatcher::MapWatcher(const std::string& directory) : fd(inotify_init1(IN_NONBLOCK | IN_CLOEXEC))
+{
+    if (fd >= 0 && inotify_add_watch(fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE) < 0)
+    {
+        close(fd);
+        fd = -1;
+    }
+}
+
+MapWatcher::~MapWatcher()
+{
+    if (fd >= 0) close(fd);
+}
+
+///@brief True, wenn der Ordner beobachtet wird
+bool MapWatcher::isOpen() const
+{
+    return fd >= 0;
+}
+
+/**
+ * @brief Liest alle Änderungen seit dem letzten Aufruf, ohne zu warten.
+ *
+ * Mehrere Ereignisse zu einer Datei werden zu einem zusammengefasst, es zählt das
+ * letzte. Ein Editor, der die alte Datei umbenennt und eine neue schreibt, ergibt
+ * so nur CHANGED. Ist die Warteschlange des Kernels übergelaufen, wird nur RESCAN
+ * gemeldet.
+ *
+ * @return Änderungen in der Reihenfolge, in der die Dateien zuerst betroffen waren
+ */
+std::vector<MapWatcher::Event> MapWatcher::poll()
+{
+    std::vector<Event> events;
+    if (fd < 0) return events;
+
+    alignas(inotify_event) char buffer[4096];
+    bool overflow = false;
+    ssize_t length;
+
+    while ((length = read(fd, buffer, sizeof(buffer))) > 0)
+    {
+        for (char* next = buffer; next < buffer + length;)
+        {
+            const auto* event = reinterpret_cast<const inotify_event*>(next);
+            next += sizeof(inotify_event) + event->len;
+
+            if ((event->mask & IN_Q_OVERFLOW) != 0) overflow = true;
+            if (event->len == 0) continue;
+
+            std::string name(event->name);
+            if (name.size() < 4 || name.compare(name.size() - 4, 4, ".txt") != 0) continue;
+
+            Event::Kind kind = (event->mask & (IN_DELETE | IN_MOVED_FROM)) != 0 ? Event::Kind::REMOVED
+                                                                               : Event::Kind::CHANGED;
+
+            bool known = false;
+            for (auto& earlier : events)
+            {
+                if (earlier.name == name)
+                {
+                    earlier.kind = kind;
+                    known = true;
+                }
+            }
+            if (!known) events.push_back({kind, name});
+        }
+    }
+
+    if (overflow) return {{Event::Kind::RESCAN, ""}};
+    return events;
+}
@@ -0,0 +1,72 @@
+#include "headers/mappedFile.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Konstruktor, öffnet die Datei und blendet sie ein.
+ *
+ * Dem Kernel wird mitgeteilt, dass die Datei von vorne nach hinten gelesen wird.
+ *
+ * @param path Pfad der Datei
+ * @post isOpen() ist true, wenn die Datei gelesen werden kann
+ */
+MappedFile::MappedFile(const std::string& path): opened(false), begin(nullptr), length(0)
+{
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return;
+
+    struct stat info{};
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode))
+    {
+        length = static_cast<size_t>(info.st_size);
+        opened = true;
+
+        if (length > 0)
+        {
+            int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+            flags |= MAP_POPULATE; //Seiten gleich einlesen, die Datei wird sowieso ganz gelesen
+#endif
+            void* mapped = mmap(nullptr, length, PROT_READ, flags, fd, 0);
+            if (mapped == MAP_FAILED)
+            {
+                opened = false;
+                length = 0;
+            } else {
+                madvise(mapped, length, MADV_SEQUENTIAL);
+                begin = static_cast<const char*>(mapped);
+            }
+        }
+    }
+
+    close(fd); //die Einblendung bleibt auch ohne offenen Deskriptor bestehen
+}
+
+///@brief Destruktor, blendet die Datei wieder aus
+MappedFile::~MappedFile()
+{
+    if (begin != nullptr)
+    {
+        munmap(const_cast<char*>(begin), length);
+    }
+}
+
+///@brief True, wenn die Datei geöffnet und eingeblendet werden konnte
+bool MappedFile::isOpen() const
+{
+    return opened;
+}
+
+///@brief Anfang des Dateiinhalts, nullptr bei einer leeren Datei
+const char* MappedFile::data() const
+{
+    return begin;
+}
+
+///@brief Größe der Datei in Bytes
+size_t MappedFile::size() const
+{
+    return length;
+}
@@ -0,0 +1,165 @@
+#include "headers/physics.h"
+#include "headers/physicsRules.h"
+#include <cassert>
+
+static_assert(TilePlanes::NONE == PlatformIndex::NONE, "PhysicsRules vergleicht beide mit PlatformIndex::NONE");
+
+namespace {
+
+/**
+ * @class LevelWorld
+ * @brief Zugriff für PhysicsRules auf ein Level im Speicher.
+ *
+ * Mit Bitebenen ist die Suche nach einer Plattform ein ctz/clz über meist ein Wort
+ * und eine Leiter ein Bittest, sonst wird im Plattformindex und in der Karte gesucht.
+ */
+class LevelWorld {
+public:
+    explicit LevelWorld(const Level& loaded) : level(loaded) {}
+
+    size_t width() const { return level.grid.getWidth(); }
+    size_t height() const { return level.grid.getHeight(); }
+
+    size_t platformAtOrBelow(size_t col, size_t row) const
+    {
+        return level.planes.empty() ? level.platforms.firstAtOrBelow(col, row) : level.planes.platformAtOrBelow(col, row);
+    }
+
+    size_t platformAtOrAbove(size_t col, size_t row) const
+    {
+        return level.planes.empty() ? level.platforms.lastAtOrAbove(col, row) : level.planes.platformAtOrAbove(col, row);
+    }
+
+    bool isLadder(size_t col, size_t row) const
+    {
+        return level.planes.empty() ? level.grid(row, col) == 'H' : level.planes.isLadder(col, row);
+    }
+
+private:
+    const Level& level;
+};
+
+}
+
+/**
+ * @brief Anfangszustand auf einer Karte: Startposition, lebendig.
+ * @param level geladene und gültige Karte
+ */
+PlayerState Physics::start(const Level& level)
+{
+    PlayerState state;
+    state.y = level.startPos[0];
+    state.x = level.startPos[1];
+
+    if (!level.transitions.empty())
+    {
+        size_t cell = level.platforms.entryOf(state.x, state.y + 1);
+        if (cell != PlatformIndex::NONE)
+        {
+            state.cell = static_cast<uint32_t>(cell);
+        }
+    }
+    return state;
+}
+
+/**
+ * @brief Führt eine Eingabe aus.
+ *
+ * Ist für die Position eine Zelle bekannt, ist der Zug ein Nachschlagen in der
+ * Übergangstabelle, sonst wird gesucht wie in scan().
+ *
+ * @param level die Karte
+ * @param state wird aktualisiert
+ * @param input 'A' links, 'D' rechts, 'F' klettern, 'E' beenden, alles andere bewirkt nichts
+ * @return MOVED, wenn sich die Position geändert hat; DIED bzw. QUIT setzen state.dead
+ */
+Physics::Outcome Physics::step(const Level& level, PlayerState& state, char input)
+{
+    if (state.cell == TransitionTable::NO_CELL)
+    {
+        return scan(level, state, input);
+    }
+
+#ifdef ADVENTURE_CHECK_TRANSITIONS
+    PlayerState scanned = state;
+    Outcome expected = scan(level, scanned, input);
+    Outcome outcome = lookup(level, state, input);
+
+    assert(outcome == expected && state.x == scanned.x && state.y == scanned.y && state.dead == scanned.dead);
+    return outcome;
+#else
+    return lookup(level, state, input);
+#endif
+}
+
+/**
+ * @brief Führt eine Eingabe mit der Übergangstabelle aus.
+ * @pre state.cell ist die Zelle von (state.x, state.y)
+ */
+Physics::Outcome Physics::lookup(const Level& level, PlayerState& state, char input)
+{
+    size_t inputSlot = TransitionTable::slot(input);
+
+    if (inputSlot == TransitionTable::INPUTS)
+    {
+        if (input == 'E')
+        {
+            state.dead = true;
+            return Outcome::QUIT;
+        }
+        return Outcome::BLOCKED;
+    }
+
+    uint32_t next = level.transitions.next(state.cell, inputSlot);
+
+    switch (next)
+    {
+        case TransitionTable::DEAD:
+            state.dead = true;
+            return Outcome::DIED;
+        case TransitionTable::STAY:
+            return Outcome::BLOCKED;
+        case TransitionTable::NO_LADDER:
+            return Outcome::NO_LADDER;
+        default:
+            state.cell = next;
+            state.x = level.transitions.column(next);
+            state.y = level.platforms.getRows()[next] - 1;
+            return Outcome::MOVED;
+    }
+}
+
+/**
+ * @brief Führt eine Eingabe aus, indem in den Bitebenen bzw. im Plattformindex gesucht wird.
+ *
+ * Mit den Regeln aus level.rules. state.cell wird nicht verändert.
+ *
+ * @param level die Karte
+ * @param state wird aktualisiert
+ * @param input 'A' links, 'D' rechts, 'F' klettern, 'E' beenden, alles andere bewirkt nichts
+ * @return wie step()
+ */
+Physics::Outcome Physics::scan(const Level& level, PlayerState& state, char input)
+{
+    return withRules(level.rules, [&](auto rules) { return scanWith<decltype(rules)>(level, state, input); });
+}
+
+/**
+ * @brief Wie scan(), aber mit einem Regelprofil, das zur Übersetzungszeit feststeht.
+ *
+ * So wird die Übergangstabelle berechnet, ohne bei jeder Zelle das Profil abzufragen.
+ */
+template <typename Rules>
+Physics::Outcome Physics::scanWith(const Level& level, PlayerState& state, char input)
+{
+    return PhysicsRules<LevelWorld, Rules>::scan(LevelWorld(level), state, input);
+}
+
+template Physics::Outcome Physics::scanWith<ClassicRules>(const Level&, PlayerState&, char);
+template Physics::Outcome Physics::scanWith<TallRules>(const Level&, PlayerState&, char);
+
+///@brief True, wenn der Spieler auf dem Ziel steht
+bool Physics::hasWon(const Level& level, const PlayerState& state)
+{
+    return level.goalPos[1] == state.x && level.goalPos[0] == state.y;
+}
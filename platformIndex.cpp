@@ -0,0 +1,106 @@
+#include "headers/platformIndex.h"
+#include "headers/profiler.h"
+#include <algorithm>
+
+/**
+ * @brief Baut den Index aus einer bereinigten Karte.
+ *
+ * Zwei Durchläufe in Zeilenreihenfolge: zuerst Plattformen pro Spalte zählen,
+ * dann die Zeilen eintragen. Die Zeilen jeder Spalte sind dadurch aufsteigend.
+ *
+ * @param grid die Karte
+ */
+void PlatformIndex::build(const Grid& grid)
+{
+    PROFILE_SCOPE("level.index");
+
+    size_t width = grid.getWidth();
+
+    offsets.assign(width + 1, 0);
+
+    for (size_t row = 0; row < grid.getHeight(); ++row)
+    {
+        const char* cells = grid.row(row);
+        for (size_t col = 0; col < width; ++col)
+        {
+            offsets[col + 1] += (cells[col] == '-');
+        }
+    }
+
+    for (size_t col = 0; col < width; ++col)
+    {
+        offsets[col + 1] += offsets[col];
+    }
+
+    rows.resize(offsets[width]);
+    std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+
+    for (size_t row = 0; row < grid.getHeight(); ++row)
+    {
+        const char* cells = grid.row(row);
+        for (size_t col = 0; col < width; ++col)
+        {
+            if (cells[col] == '-')
+            {
+                rows[fill[col]++] = static_cast<uint32_t>(row);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Erste Plattform in Spalte col, die in Zeile row oder darunter liegt.
+ * @return Zeile der Plattform oder NONE
+ */
+size_t PlatformIndex::firstAtOrBelow(size_t col, size_t row) const
+{
+    auto begin = rows.begin() + offsets[col];
+    auto end = rows.begin() + offsets[col + 1];
+
+    auto found = std::lower_bound(begin, end, row, [](uint32_t platform, size_t value) { return platform < value; });
+
+    return found == end ? NONE : *found;
+}
+
+/**
+ * @brief Letzte Plattform in Spalte col, die in Zeile row oder darüber liegt.
+ * @return Zeile der Plattform oder NONE
+ */
+size_t PlatformIndex::lastAtOrAbove(size_t col, size_t row) const
+{
+    auto begin = rows.begin() + offsets[col];
+    auto end = rows.begin() + offsets[col + 1];
+
+    auto found = std::upper_bound(begin, end, row, [](size_t value, uint32_t platform) { return value < platform; });
+
+    return found == begin ? NONE : *(found - 1);
+}
+
+/**
+ * @brief Position der Plattform (col, row) in getRows().
+ *
+ * Jede Plattformzelle hat so eine feste Nummer zwischen 0 und getRows().size() - 1.
+ *
+ * @return Index in getRows() oder NONE, wenn dort keine Plattform ist
+ */
+size_t PlatformIndex::entryOf(size_t col, size_t row) const
+{
+    auto begin = rows.begin() + offsets[col];
+    auto end = rows.begin() + offsets[col + 1];
+
+    auto found = std::lower_bound(begin, end, row, [](uint32_t platform, size_t value) { return platform < value; });
+
+    return (found == end || *found != row) ? NONE : static_cast<size_t>(found - rows.begin());
+}
+
+///@brief Anfang der Einträge jeder Spalte in getRows()
+const std::vector<uint32_t>& PlatformIndex::getOffsets() const
+{
+    return offsets;
+}
+
+///@brief Plattformzeilen aller Spalten hintereinander
+const std::vector<uint32_t>& PlatformIndex::getRows() const
+{
+    return rows;
+}
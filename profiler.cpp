@@ -0,0 +1,200 @@
+#include "headers/profiler.h"
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+const size_t MAX_TRACE_EVENTS = size_t{1} << 20; ///< danach werden keine Ereignisse mehr gespeichert
+
+struct TraceEvent {
+    const char* name;
+    uint32_t thread;
+    int64_t startNs, durationNs;
+};
+
+std::atomic<Profiler::Site*> sites{nullptr};
+std::atomic<Profiler::Counter*> counters{nullptr};
+
+std::atomic<bool> tracing{false};
+std::mutex traceMutex;
+std::vector<TraceEvent> traceEvents;
+Profiler::Clock::time_point traceStart;
+
+std::atomic<uint32_t> threadCount{0};
+
+///@brief Kleine fortlaufende Nummer für den aktuellen Thread, für "tid" im Trace
+uint32_t threadNumber()
+{
+    thread_local uint32_t number = threadCount.fetch_add(1, std::memory_order_relaxed) + 1;
+    return number;
+}
+
+///@brief Hängt ein Element vorne an eine Liste an, auch wenn andere Threads gleichzeitig anhängen
+template <typename T>
+void push(std::atomic<T*>& head, T* element)
+{
+    element->next = head.load(std::memory_order_relaxed);
+    while (!head.compare_exchange_weak(element->next, element, std::memory_order_release, std::memory_order_relaxed))
+    {
+    }
+}
+
+}
+
+/**
+ * @brief Konstruktor, meldet die Stelle an.
+ * @param label Name der Stelle, muss ein String-Literal sein (wird nicht kopiert)
+ */
+Profiler::Site::Site(const char* label)
+        : name(label), next(nullptr)
+{
+    push(sites, this);
+}
+
+/**
+ * @brief Konstruktor, meldet den Zähler an.
+ * @param label Name des Zählers, muss ein String-Literal sein (wird nicht kopiert)
+ */
+Profiler::Counter::Counter(const char* label)
+        : name(label), next(nullptr)
+{
+    push(counters, this);
+}
+
+///@brief Bucht die gemessene Zeit auf die Stelle und speichert sie im Trace, falls aktiv
+Profiler::Scope::~Scope()
+{
+    Clock::time_point end = Clock::now();
+    auto duration = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+
+    site.calls.fetch_add(1, std::memory_order_relaxed);
+    site.totalNs.fetch_add(duration, std::memory_order_relaxed);
+    site.lastNs.store(duration, std::memory_order_relaxed);
+
+    uint64_t max = site.maxNs.load(std::memory_order_relaxed);
+    while (duration > max && !site.maxNs.compare_exchange_weak(max, duration, std::memory_order_relaxed))
+    {
+    }
+
+    if (!tracing.load(std::memory_order_relaxed)) return;
+
+    std::lock_guard<std::mutex> lock(traceMutex);
+    if (traceEvents.size() < MAX_TRACE_EVENTS)
+    {
+        traceEvents.push_back({site.name, threadNumber(),
+                               std::chrono::duration_cast<std::chrono::nanoseconds>(start - traceStart).count(),
+                               static_cast<int64_t>(duration)});
+    }
+}
+
+/**
+ * @brief Speichert ab jetzt jede Messung als Ereignis für writeTrace().
+ *
+ * Sollte vor dem ersten Laden aufgerufen werden, damit auch die Ladephasen im Trace sind.
+ */
+void Profiler::enableTrace()
+{
+    std::lock_guard<std::mutex> lock(traceMutex);
+    traceStart = Clock::now();
+    traceEvents.reserve(4096);
+    tracing.store(true, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Schreibt alle gespeicherten Ereignisse als Chrome trace_event JSON.
+ *
+ * Messungen werden als "X"-Ereignisse (Dauer) geschrieben, die Zähler am Ende
+ * einmal als "C"-Ereignisse mit ihrem Endstand.
+ *
+ * @param path Zieldatei
+ * @return False, wenn die Datei nicht geschrieben werden konnte
+ */
+bool Profiler::writeTrace(const std::string& path)
+{
+    std::FILE* out = std::fopen(path.c_str(), "w");
+    if (out == nullptr) return false;
+
+    std::lock_guard<std::mutex> lock(traceMutex);
+
+    int64_t lastUs = 0;
+    std::fprintf(out, "{\"traceEvents\": [\n");
+    for (const TraceEvent& event : traceEvents)
+    {
+        std::fprintf(out, "  {\"name\": \"%s\", \"ph\": \"X\", \"pid\": 1, \"tid\": %" PRIu32 ", \"ts\": %.3f, \"dur\": %.3f},\n",
+                     event.name, event.thread, static_cast<double>(event.startNs) / 1000,
+                     static_cast<double>(event.durationNs) / 1000);
+        lastUs = std::max(lastUs, (event.startNs + event.durationNs) / 1000);
+    }
+
+    for (Counter* counter = counters.load(std::memory_order_acquire); counter != nullptr; counter = counter->next)
+    {
+        std::fprintf(out, "  {\"name\": \"%s\", \"ph\": \"C\", \"pid\": 1, \"ts\": %" PRId64 ", \"args\": {\"value\": %" PRIu64 "}},\n",
+                     counter->name, lastUs, counter->value.load(std::memory_order_relaxed));
+    }
+
+    std::fprintf(out, "  {\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"args\": {\"name\": \"adventure\"}}\n]}\n");
+
+    return std::fclose(out) == 0;
+}
+
+/**
+ * @brief Gibt alle Stellen (Aufrufe, Summe, Mittel, Maximum) und Zähler aus.
+ */
+void Profiler::printSummary(std::ostream& out)
+{
+    if (!COMPILED)
+    {
+        out << "Profiling ist nicht einkompiliert (-DADVENTURE_PROFILE)\n";
+        return;
+    }
+
+    char line[160];
+
+    std::snprintf(line, sizeof(line), "%-24s %10s %12s %12s %12s\n", "Messung", "Aufrufe", "Summe [ms]", "Mittel [us]", "Max [us]");
+    out << line;
+
+    for (Site* site = sites.load(std::memory_order_acquire); site != nullptr; site = site->next)
+    {
+        uint64_t calls = site->calls.load(std::memory_order_relaxed);
+        double total = static_cast<double>(site->totalNs.load(std::memory_order_relaxed));
+
+        std::snprintf(line, sizeof(line), "%-24s %10" PRIu64 " %12.3f %12.3f %12.3f\n", site->name, calls, total / 1e6,
+                      calls == 0 ? 0.0 : total / static_cast<double>(calls) / 1e3,
+                      static_cast<double>(site->maxNs.load(std::memory_order_relaxed)) / 1e3);
+        out << line;
+    }
+
+    for (Counter* counter = counters.load(std::memory_order_acquire); counter != nullptr; counter = counter->next)
+    {
+        std::snprintf(line, sizeof(line), "%-24s %10" PRIu64 "\n", counter->name, counter->value.load(std::memory_order_relaxed));
+        out << line;
+    }
+}
+
+/**
+ * @brief Eine Zeile mit der letzten Dauer jeder Stelle und dem Stand jedes Zählers.
+ */
+std::string Profiler::hudLine()
+{
+    std::string hud;
+    char item[96];
+
+    for (Site* site = sites.load(std::memory_order_acquire); site != nullptr; site = site->next)
+    {
+        std::snprintf(item, sizeof(item), "%s%s %.1fus", hud.empty() ? "" : " | ", site->name,
+                      static_cast<double>(site->lastNs.load(std::memory_order_relaxed)) / 1e3);
+        hud += item;
+    }
+
+    for (Counter* counter = counters.load(std::memory_order_acquire); counter != nullptr; counter = counter->next)
+    {
+        std::snprintf(item, sizeof(item), "%s%s %" PRIu64, hud.empty() ? "" : " | ", counter->name,
+                      counter->value.load(std::memory_order_relaxed));
+        hud += item;
+    }
+
+    return hud;
+}
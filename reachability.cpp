@@ -0,0 +1,124 @@
+#include "headers/reachability.h"
+#include "headers/profiler.h"
+#include <algorithm>
+
+namespace {
+
+const uint32_t NO_PARENT = UINT32_MAX;
+
+bool isVisited(const std::vector<uint64_t>& visited, size_t state)
+{
+    return (visited[state / 64] >> (state % 64)) & 1u;
+}
+
+}
+
+/**
+ * @brief Sucht die kürzeste Eingabefolge vom Start zum Ziel.
+ *
+ * @param level Karte mit Plattformindex, Übergangstabelle, Start- und Zielposition
+ * @param pool Threads für große Ebenen oder nullptr
+ * @return reachable = false, wenn das Ziel nach den Spielregeln nicht erreichbar ist
+ * @pre level.transitions ist berechnet
+ */
+Solution Reachability::solve(const Level& level, ThreadPool* pool)
+{
+    PROFILE_SCOPE("level.solve");
+
+    const PlatformIndex& platforms = level.platforms;
+    size_t states = platforms.getRows().size();
+
+    Solution solution;
+
+    size_t start = platforms.entryOf(level.startPos[1], level.startPos[0] + 1);
+    size_t goal = platforms.entryOf(level.goalPos[1], level.goalPos[0] + 1);
+
+    if (start == PlatformIndex::NONE || goal == PlatformIndex::NONE) return solution;
+
+    std::vector<uint64_t> visited((states + 63) / 64, 0);
+    std::vector<uint32_t> parent(states, NO_PARENT);
+    std::vector<uint8_t> parentInput(states, 0);
+
+    visited[start / 64] |= uint64_t(1) << (start % 64);
+    solution.visitedStates = 1;
+
+    std::vector<uint32_t> frontier{static_cast<uint32_t>(start)}, next;
+    std::vector<std::vector<Edge>> edges(pool != nullptr ? pool->size() + 1 : 1);
+
+    while (!frontier.empty() && !isVisited(visited, goal))
+    {
+        size_t ranges = 1;
+        if (pool != nullptr && frontier.size() >= MIN_PARALLEL)
+        {
+            ranges = edges.size();
+        }
+
+        if (ranges == 1)
+        {
+            edges[0].clear();
+            expand(level, frontier, 0, frontier.size(), visited, edges[0]);
+        } else {
+            pool->parallelFor(ranges, [&](size_t range) {
+                edges[range].clear();
+                expand(level, frontier, frontier.size() * range / ranges, frontier.size() * (range + 1) / ranges,
+                       visited, edges[range]);
+            });
+        }
+
+        //in Reihenfolge der Bereiche eintragen: derselbe Vorgänger wie bei einer Suche ohne Threads
+        next.clear();
+        for (size_t range = 0; range < ranges; ++range)
+        {
+            for (const Edge& edge : edges[range])
+            {
+                uint32_t target = edge.target;
+                if (isVisited(visited, target)) continue;
+
+                visited[target / 64] |= uint64_t(1) << (target % 64);
+                parent[target] = edge.source;
+                parentInput[target] = edge.input;
+                next.push_back(target);
+            }
+        }
+
+        solution.visitedStates += next.size();
+        frontier.swap(next);
+    }
+
+    if (!isVisited(visited, goal)) return solution;
+
+    solution.reachable = true;
+    for (size_t state = goal; state != start; state = parent[state])
+    {
+        solution.inputs.push_back(static_cast<char>(parentInput[state]));
+    }
+    std::reverse(solution.inputs.begin(), solution.inputs.end());
+
+    return solution;
+}
+
+/**
+ * @brief Berechnet die noch nicht besuchten Nachfolger von frontier[first, last).
+ *
+ * Liest visited nur, damit mehrere Bereiche gleichzeitig laufen können.
+ *
+ * @param edges gefundene Nachfolger, in Reihenfolge der Frontier und der Eingaben
+ */
+void Reachability::expand(const Level& level, const std::vector<uint32_t>& frontier, size_t first, size_t last,
+                          const std::vector<uint64_t>& visited, std::vector<Edge>& edges)
+{
+    for (size_t i = first; i < last; ++i)
+    {
+        uint32_t source = frontier[i];
+
+        for (size_t inputSlot = 0; inputSlot < TransitionTable::INPUTS; ++inputSlot)
+        {
+            uint32_t target = level.transitions.next(source, inputSlot);
+
+            //DEAD, STAY und NO_LADDER liegen über allen Zellnummern
+            if (target >= TransitionTable::NO_CELL || isVisited(visited, target)) continue;
+
+            edges.push_back({target, source, static_cast<uint8_t>(INPUTS[inputSlot])});
+        }
+    }
+}
@@ -0,0 +1,496 @@
+#include "headers/renderer.h"
+#include "headers/profiler.h"
+#include <algorithm>
+#include <charconv>
+#include <cerrno>
+#include <iostream>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+/**
+ * @brief Konstruktor, initialisiert den Renderer für die gegebene Ausgabe.
+ *
+ * ANSI-Cursorsteuerung wird nur benutzt, wenn die Ausgabe ein Terminal ist.
+ * Sonst (z.B. Umleitung in eine Datei) wird jedes Bild vollständig als Text ausgegeben.
+ *
+ * @param fileDescriptor Ausgabe, in die gezeichnet wird (z.B. STDOUT_FILENO)
+ */
+Renderer::Renderer(int fileDescriptor)
+        : fd(fileDescriptor), ansi(isatty(fileDescriptor) == 1), fixedSize(false), mode(Mode::CAMERA),
+          deadZone(AUTO_DEAD_ZONE), playerHeight(1), viewTop(0), viewLeft(0), viewRows(0), viewCols(0),
+          shownX(0), shownY(0), termRows(0), termCols(0), anchored(false), messageCount(0)
+{
+}
+
+/**
+ * @brief Konstruktor für ein gedachtes Terminal fester Größe, z.B. für Aufnahmen.
+ *
+ * Es wird mit ANSI-Cursorsteuerung gezeichnet wie in einem echten Terminal dieser
+ * Größe, ausgegeben wird mit output() der abgeleiteten Klasse.
+ *
+ * @param rows Zeilen des Terminals
+ * @param cols Spalten des Terminals
+ */
+Renderer::Renderer(unsigned short rows, unsigned short cols)
+        : fd(-1), ansi(true), fixedSize(true), mode(Mode::CAMERA), deadZone(AUTO_DEAD_ZONE), playerHeight(1),
+          viewTop(0), viewLeft(0), viewRows(0), viewCols(0), shownX(0), shownY(0), termRows(rows), termCols(cols),
+          anchored(false), messageCount(0)
+{
+}
+
+namespace {
+
+/**
+ * @brief Verschiebt den Ausschnitt auf einer Achse so wenig wie möglich.
+ *
+ * Der Ausschnitt bleibt stehen, solange pos mindestens margin Zellen von beiden
+ * Rändern entfernt ist. Am Kartenrand wird er nicht über die Karte hinaus geschoben.
+ *
+ * @param origin bisheriger Anfang des Ausschnitts
+ * @param pos Position des Spielers
+ * @param view Größe des Ausschnitts, 1 <= view <= total
+ * @param total Größe der Karte
+ * @param margin Abstand zum Rand, ab dem verschoben wird
+ * @return neuer Anfang, pos liegt immer im Ausschnitt
+ */
+size_t scrollAxis(size_t origin, size_t pos, size_t view, size_t total, size_t margin)
+{
+    margin = std::min(margin, (view - 1) / 2);
+
+    if (pos < origin + margin)
+    {
+        origin = pos > margin ? pos - margin : 0;
+    } else if (pos + margin >= origin + view)
+    {
+        origin = pos + margin + 1 - view;
+    }
+
+    return std::min(origin, total - view);
+}
+
+///@brief Anfang eines Ausschnitts, in dessen Mitte pos liegt
+size_t centerAxis(size_t pos, size_t view, size_t total)
+{
+    return std::min(pos > view / 2 ? pos - view / 2 : 0, total - view);
+}
+
+///@brief Hängt die ANSI-Sequenz für die Cursorposition (row, col) an, 0-basiert
+void appendCursor(std::string& out, size_t row, size_t col)
+{
+    char number[24];
+
+    out.append("\x1b[");
+    out.append(number, static_cast<size_t>(std::to_chars(number, number + sizeof(number), row + 1).ptr - number));
+    out.push_back(';');
+    out.append(number, static_cast<size_t>(std::to_chars(number, number + sizeof(number), col + 1).ptr - number));
+    out.push_back('H');
+}
+
+/**
+ * @brief Kürzt eine Zeile auf höchstens cols Bytes, ohne ein UTF-8-Zeichen zu teilen.
+ *
+ * Eine längere Zeile würde im Terminal umbrechen und auf der letzten Zeile scrollen.
+ */
+std::string fitLine(const std::string& line, size_t cols)
+{
+    if (line.size() <= cols) return line;
+
+    size_t length = cols;
+    while (length > 0 && (static_cast<unsigned char>(line[length]) & 0xC0) == 0x80) --length;
+    return line.substr(0, length);
+}
+
+}
+
+/**
+ * @brief Zeichnet die Karte mit P-symbol (player).
+ *
+ * Ist dieselbe Karte schon zu sehen und hat sich die Terminalgröße nicht geändert,
+ * werden nur die alte und die neue Spielerposition neu gezeichnet. Sonst wird das
+ * ganze Bild neu aufgebaut. Im Modus CAMERA ist das ganze Bild nur der Ausschnitt,
+ * der auch neu aufgebaut wird, wenn er dem Spieler folgen muss.
+ *
+ * @param grid  Schnappschuss der Karte
+ * @param playerX x-position von Player
+ * @param playerY y-position von Player
+ * @post Das Bild ist mit einem write(2) ausgegeben, getLastFrameBytes() ist aktualisiert
+ */
+void Renderer::drawFrame(const std::shared_ptr<const Grid>& grid, size_t playerX, size_t playerY)
+{
+    frame.clear();
+
+    bool resized = terminalChanged();
+    bool sameMap = shownMap == grid;
+
+    if (ansi && mode == Mode::CAMERA && termRows > reservedRows() && termCols > 0)
+    {
+        bool scrolled = follow(*grid, playerX, playerY, resized || !sameMap);
+
+        if (!resized && sameMap && !scrolled)
+        {
+            composeDiff(*grid, playerX, playerY);
+        } else {
+            composeView(*grid, playerX, playerY);
+        }
+        anchored = true;
+    } else if (ansi && !resized && sameMap && fitsTerminal(*grid))
+    {
+        composeDiff(*grid, playerX, playerY);
+        anchored = true;
+    } else {
+        viewTop = viewLeft = 0;
+        viewRows = grid->getHeight();
+        viewCols = grid->getWidth();
+        composeFull(*grid, playerX, playerY);
+        anchored = ansi && fitsTerminal(*grid); //sonst ist der Bildschirm nicht geleert und gescrollt
+    }
+
+    shownMap = grid;
+    shownX = playerX;
+    shownY = playerY;
+    messageCount = 0; //das Bild hat die Meldungszeilen geleert
+
+    flush();
+}
+
+/**
+ * @brief Gibt eine Meldung in einer der MESSAGE_ROWS Zeilen unter Bild und Fußzeile aus.
+ *
+ * Die Meldungen nach einem Bild oder einer Eingabeaufforderung füllen diese Zeilen
+ * von oben, weitere überschreiben die letzte. Der Cursor wird danach wieder dorthin
+ * gesetzt, wo er vorher stand, es wird also nichts verschoben und nichts gescrollt.
+ * Das nächste Bild löscht die Meldungen wieder. Steht kein Bild oben im Terminal
+ * (kein ANSI, Karte zu groß), wird die Meldung einfach als Zeile ausgegeben.
+ *
+ * @param line eine Zeile ohne '\n'
+ */
+void Renderer::message(const std::string& line)
+{
+    if (!anchored)
+    {
+        output(line + "\n");
+        return;
+    }
+
+    size_t first = viewRows + (footer.empty() ? 0 : 1);
+
+    std::string bytes = "\x1b" "7"; //Cursor merken
+    if (messageCount == 0) //Meldungen zum vorigen Zug löschen
+    {
+        for (size_t row = first + 1; row < first + MESSAGE_ROWS; ++row)
+        {
+            appendCursor(bytes, row, 0);
+            bytes.append("\x1b[K");
+        }
+    }
+    appendCursor(bytes, first + std::min(messageCount, MESSAGE_ROWS - 1), 0);
+    bytes.append(fitLine(line, termCols));
+    bytes.append("\x1b[K\x1b" "8");
+
+    ++messageCount;
+    output(bytes);
+}
+
+/**
+ * @brief Erzwingt beim nächsten Bild ein vollständiges Neuzeichnen.
+ */
+void Renderer::invalidate()
+{
+    shownMap.reset();
+}
+
+/**
+ * @brief Wählt zwischen Ausschnitt (CAMERA) und ganzer Karte (FULL).
+ * @post Das nächste Bild wird vollständig gezeichnet
+ */
+void Renderer::setMode(Mode newMode)
+{
+    mode = newMode;
+    invalidate();
+}
+
+/**
+ * @brief Setzt den Abstand zum Rand des Ausschnitts, ab dem die Kamera nachzieht.
+ * @param cells Abstand in Zellen, AUTO_DEAD_ZONE für ein Viertel des Ausschnitts;
+ *              wird auf die halbe Größe des Ausschnitts begrenzt
+ */
+void Renderer::setDeadZone(size_t cells)
+{
+    deadZone = cells;
+}
+
+/**
+ * @brief Setzt die Höhe des Spielers, er wird von playerY an so viele Zeilen nach oben gezeichnet.
+ * @param rows mindestens 1
+ * @post Das nächste Bild wird vollständig gezeichnet
+ */
+void Renderer::setPlayerHeight(size_t rows)
+{
+    playerHeight = std::max<size_t>(rows, 1);
+    invalidate();
+}
+
+/**
+ * @brief Setzt die Fußzeile unter dem Bild.
+ * @param line eine Zeile ohne '\n', leer für keine Fußzeile
+ * @post Das nächste Bild wird vollständig gezeichnet
+ */
+void Renderer::setFooter(const std::string& line)
+{
+    footer = line;
+    invalidate();
+}
+
+/**
+ * @brief Setzt die Eingabeaufforderung für den Zeilenmodus.
+ *
+ * Für sie, die Eingabe und die Zeile nach Enter bleiben PROMPT_ROWS Zeilen unter dem
+ * Bild frei.
+ *
+ * @param line eine Zeile ohne '\n', leer für keine
+ * @post Das nächste Bild wird vollständig gezeichnet
+ */
+void Renderer::setPrompt(const std::string& line)
+{
+    promptLine = line;
+    invalidate();
+}
+
+/**
+ * @brief Zeigt die Eingabeaufforderung, der Cursor steht danach am Anfang der Zeile darunter.
+ *
+ * Steht das letzte Bild oben im Terminal, wird die Aufforderung immer an dieselbe
+ * Stelle unter den Meldungszeilen gezeichnet und die alte Eingabe gelöscht. So wandert sie
+ * auch bei Zügen ohne neues Bild nicht nach unten. Sonst wird sie einfach ausgegeben.
+ */
+void Renderer::prompt()
+{
+    if (promptLine.empty()) return;
+
+    if (!anchored)
+    {
+        output(promptLine + "\n");
+        return;
+    }
+
+    std::string bytes;
+    appendCursor(bytes, viewRows + (footer.empty() ? 0 : 1) + MESSAGE_ROWS, 0);
+    bytes.append(fitLine(promptLine, termCols));
+    bytes.append("\x1b[K\n\x1b[J");
+    output(bytes);
+
+    messageCount = 0; //die nächste Meldung gehört zum nächsten Zug
+}
+
+/**
+ * @brief Prüft, ob sich die Terminalgröße seit dem letzten Bild geändert hat.
+ * @return True, wenn die Größe anders ist als beim letzten Aufruf
+ */
+bool Renderer::terminalChanged()
+{
+    if (!ansi || fixedSize) return false;
+
+    winsize size{};
+    if (ioctl(fd, TIOCGWINSZ, &size) != 0) return false;
+
+    bool changed = size.ws_row != termRows || size.ws_col != termCols;
+
+    termRows = size.ws_row;
+    termCols = size.ws_col;
+
+    return changed;
+}
+
+/**
+ * @brief Zeilen unter dem Bild: Fußzeile, Meldungen und Eingabeaufforderung mit Eingabe.
+ *
+ * Nach einem Bild steht der Cursor auf der ersten Meldungszeile.
+ */
+size_t Renderer::reservedRows() const
+{
+    return (footer.empty() ? 0 : 1) + MESSAGE_ROWS + (promptLine.empty() ? 0 : PROMPT_ROWS);
+}
+
+/**
+ * @brief Passt die Karte (plus die Zeilen darunter, siehe reservedRows()) komplett ins Terminal?
+ *
+ * Nur dann stimmen die Cursorpositionen, sonst scrollt das Terminal.
+ */
+bool Renderer::fitsTerminal(const Grid& grid) const
+{
+    return grid.getHeight() + reservedRows() <= termRows && grid.getWidth() <= termCols;
+}
+
+/**
+ * @brief Passt den Ausschnitt an Terminalgröße und Spielerposition an.
+ *
+ * Der Ausschnitt ist so groß wie das Terminal ohne die Zeilen darunter (reservedRows()),
+ * aber nicht größer als die Karte.
+ *
+ * @param recenter True, wenn der Spieler in die Mitte gesetzt werden soll (neue Karte, neue Größe)
+ * @return True, wenn sich der Ausschnitt geändert hat
+ */
+bool Renderer::follow(const Grid& grid, size_t playerX, size_t playerY, bool recenter)
+{
+    size_t rows = std::min<size_t>(grid.getHeight(), termRows - reservedRows());
+    size_t cols = std::min<size_t>(grid.getWidth(), termCols);
+
+    size_t top, left;
+    if (recenter)
+    {
+        top = centerAxis(playerY, rows, grid.getHeight());
+        left = centerAxis(playerX, cols, grid.getWidth());
+    } else {
+        top = scrollAxis(viewTop, playerY, rows, grid.getHeight(), deadZone == AUTO_DEAD_ZONE ? rows / 4 : deadZone);
+        left = scrollAxis(viewLeft, playerX, cols, grid.getWidth(), deadZone == AUTO_DEAD_ZONE ? cols / 4 : deadZone);
+    }
+
+    bool changed = top != viewTop || left != viewLeft || rows != viewRows || cols != viewCols;
+
+    viewTop = top;
+    viewLeft = left;
+    viewRows = rows;
+    viewCols = cols;
+
+    return changed;
+}
+
+/**
+ * @brief Baut das ganze Bild im Puffer auf.
+ *
+ * Im Terminal wird vorher der Bildschirm geleert, wenn die Karte hineinpasst.
+ */
+void Renderer::composeFull(const Grid& grid, size_t playerX, size_t playerY)
+{
+    size_t width = grid.getWidth();
+    bool clearScreen = ansi && fitsTerminal(grid);
+
+    frame.reserve(grid.getHeight() * (width + 1) + 16);
+
+    if (clearScreen)
+    {
+        frame.append("\x1b[H\x1b[2J");
+    }
+
+    for (size_t row = 0; row < grid.getHeight(); ++row)
+    {
+        frame.append(grid.row(row), width);
+        if (isPlayerRow(row, playerY))
+        {
+            frame[frame.size() - width + playerX] = 'P';
+        }
+        frame.push_back('\n');
+    }
+
+    appendFooter();
+}
+
+/**
+ * @brief Baut den Ausschnitt im Puffer auf, nach dem Leeren des Bildschirms.
+ *
+ * Kopiert nur viewRows x viewCols Zellen, die Größe der Karte spielt keine Rolle.
+ * Passt die Karte ganz ins Terminal, ist das Bild dasselbe wie bei composeFull().
+ */
+void Renderer::composeView(const Grid& grid, size_t playerX, size_t playerY)
+{
+    frame.reserve(viewRows * (viewCols + 1) + 16);
+    frame.append("\x1b[H\x1b[2J");
+
+    for (size_t row = viewTop; row < viewTop + viewRows; ++row)
+    {
+        frame.append(grid.row(row) + viewLeft, viewCols);
+        if (isPlayerRow(row, playerY))
+        {
+            frame[frame.size() - viewCols + (playerX - viewLeft)] = 'P';
+        }
+        frame.push_back('\n');
+    }
+
+    appendFooter();
+}
+
+/**
+ * @brief Zeichnet nur die geänderten Zellen: alte Position wiederherstellen, P setzen.
+ *
+ * Ein Spieler mit mehreren Zeilen wird ganz wiederhergestellt und neu gesetzt, Zeilen
+ * über dem Ausschnitt werden ausgelassen.
+ * Die Positionen sind relativ zum Ausschnitt, der sich seit dem letzten Bild nicht
+ * verschoben hat. Danach steht der Cursor unter dem Ausschnitt und der Fußzeile und
+ * der Rest des Bildschirms ist geleert, damit die nächsten Ausgaben (Steuerung, Meldungen) an
+ * derselben Stelle stehen.
+ */
+void Renderer::composeDiff(const Grid& grid, size_t playerX, size_t playerY)
+{
+    if (shownX != playerX || shownY != playerY)
+    {
+        for (size_t row = shownY + 1; row-- > viewTop && isPlayerRow(row, shownY);)
+        {
+            appendCursor(frame, row - viewTop, shownX - viewLeft);
+            frame.push_back(grid(row, shownX));
+        }
+
+        for (size_t row = playerY + 1; row-- > viewTop && isPlayerRow(row, playerY);)
+        {
+            appendCursor(frame, row - viewTop, playerX - viewLeft);
+            frame.push_back('P');
+        }
+    }
+
+    appendCursor(frame, viewRows + (footer.empty() ? 0 : 1), 0);
+    frame.append("\x1b[J");
+}
+
+///@brief True, wenn der Spieler, der über Zeile playerY steht, die Zeile row belegt
+bool Renderer::isPlayerRow(size_t row, size_t playerY) const
+{
+    return row <= playerY && row + playerHeight > playerY;
+}
+
+///@brief Hängt die Fußzeile an, falls es eine gibt, im Terminal auf dessen Breite gekürzt
+void Renderer::appendFooter()
+{
+    if (footer.empty()) return;
+
+    frame.append(ansi && termCols > 0 ? fitLine(footer, termCols) : footer);
+    frame.push_back('\n');
+}
+
+/**
+ * @brief Gibt den Puffer aus und zählt das Bild.
+ */
+void Renderer::flush()
+{
+    output(frame);
+
+    PROFILE_COUNT("render.bytes", frame.size());
+
+    countFrame(frame.size());
+}
+
+/**
+ * @brief Gibt ein fertiges Bild mit einem write(2) aus.
+ *
+ * Vorher wird std::cout geleert, damit Meldungen vor dem Bild in der richtigen
+ * Reihenfolge erscheinen. Wird nur ein Teil geschrieben, wird der Rest nachgeschoben.
+ *
+ * @param bytes das ganze Bild mit ANSI-Sequenzen
+ */
+void Renderer::output(const std::string& bytes)
+{
+    std::cout.flush();
+
+    const char* data = bytes.data();
+    size_t left = bytes.size();
+
+    while (left > 0)
+    {
+        ssize_t written = write(fd, data, left);
+        if (written < 0)
+        {
+            if (errno == EINTR) continue;
+            break;
+        }
+        data += written;
+        left -= static_cast<size_t>(written);
+    }
+}
@@ -0,0 +1,38 @@
+#include "headers/simulation.h"
+
+/**
+ * @brief Spielt eine Eingabefolge vom Start der Karte aus ab.
+ *
+ * Leerraum (Leerzeichen, Zeilenumbrüche) wird übersprungen wie bei std::cin >> char.
+ * Eingaben nach dem Spielende werden nicht mehr verarbeitet.
+ *
+ * @param level geladene und gültige Karte
+ * @param inputs Eingaben, z.B. "DDDFAAD"
+ * @return Endzustand; weder won noch dead, wenn die Eingaben vor dem Spielende ausgehen
+ */
+SimulationResult Simulation::run(const Level& level, std::string_view inputs)
+{
+    PlayerState state = Physics::start(level);
+    SimulationResult result;
+
+    for (char input : inputs)
+    {
+        if (input == ' ' || (input >= '\t' && input <= '\r')) continue;
+
+        ++result.steps;
+        Physics::step(level, state, input);
+
+        if (state.dead) break;
+        if (Physics::hasWon(level, state))
+        {
+            result.won = true;
+            break;
+        }
+    }
+
+    result.dead = state.dead;
+    result.x = state.x;
+    result.y = state.y;
+
+    return result;
+}
@@ -0,0 +1,74 @@
+#include "headers/terminalInput.h"
+#include <cerrno>
+#include <poll.h>
+#include <unistd.h>
+
+/**
+ * @brief Konstruktor, schaltet die Standardeingabe in den Rohmodus, falls sie ein Terminal ist.
+ *
+ * VMIN = VTIME = 0: read() kehrt sofort zurück, auch wenn keine Taste gedrückt wurde.
+ * Die Ausgabe bleibt unverändert, '\n' wird also weiter zu "\r\n".
+ */
+TerminalInput::TerminalInput()
+        : raw(false), saved()
+{
+    if (isatty(STDIN_FILENO) != 1 || tcgetattr(STDIN_FILENO, &saved) != 0) return;
+
+    termios settings = saved;
+    settings.c_lflag &= ~static_cast<tcflag_t>(ICANON | ECHO | ISIG);
+    settings.c_iflag &= ~static_cast<tcflag_t>(IXON | ICRNL);
+    settings.c_cc[VMIN] = 0;
+    settings.c_cc[VTIME] = 0;
+
+    raw = tcsetattr(STDIN_FILENO, TCSANOW, &settings) == 0;
+}
+
+/**
+ * @brief Destruktor, stellt die alten Terminaleinstellungen wieder her.
+ *
+ * Noch nicht gelesene Tasten (z.B. von einer gehaltenen Taste) werden verworfen,
+ * damit sie nicht im Menü landen.
+ */
+TerminalInput::~TerminalInput()
+{
+    if (raw)
+    {
+        tcsetattr(STDIN_FILENO, TCSAFLUSH, &saved);
+    }
+}
+
+///@brief True, wenn die Eingabe im Rohmodus ist
+bool TerminalInput::isRaw() const
+{
+    return raw;
+}
+
+/**
+ * @brief Wartet, bis eine Taste gedrückt wurde, höchstens bis deadline.
+ * @return True, wenn Eingabe zum Lesen bereit ist
+ */
+bool TerminalInput::waitUntil(Clock::time_point deadline) const
+{
+    for (;;)
+    {
+        auto left = std::chrono::ceil<std::chrono::milliseconds>(deadline - Clock::now()).count();
+        if (left < 0) left = 0;
+
+        pollfd input{STDIN_FILENO, POLLIN, 0};
+        int ready = poll(&input, 1, static_cast<int>(left));
+
+        if (ready > 0) return true;
+        if (ready == 0 && Clock::now() >= deadline) return false;
+        if (ready < 0 && errno != EINTR) return false;
+    }
+}
+
+/**
+ * @brief Liest alle schon gedrückten Tasten, ohne zu blockieren.
+ * @return Anzahl gelesener Zeichen, 0 wenn keine Taste anliegt
+ */
+size_t TerminalInput::read(char* buffer, size_t size) const
+{
+    ssize_t count = ::read(STDIN_FILENO, buffer, size);
+    return count > 0 ? static_cast<size_t>(count) : 0;
+}
@@ -0,0 +1,152 @@
+#include "headers/threadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+/**
+ * @brief Konstruktor, startet die Arbeitsthreads.
+ * @param threads Anzahl der Threads, mindestens 1
+ */
+ThreadPool::ThreadPool(size_t threads): running(0), stopping(false)
+{
+    if (threads == 0) threads = 1;
+
+    workers.reserve(threads);
+    for (size_t i = 0; i < threads; ++i)
+    {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+/**
+ * @brief Destruktor, arbeitet die restlichen Aufgaben ab und beendet die Threads.
+ */
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    taskReady.notify_all();
+
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Stellt eine Aufgabe in die Warteschlange.
+ * @param task die Aufgabe, wird von irgendeinem Arbeitsthread ausgeführt; darf keine
+ *             Ausnahme werfen, sonst endet das Programm (std::terminate)
+ */
+void ThreadPool::submit(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+    }
+    taskReady.notify_one();
+}
+
+/**
+ * @brief Wartet, bis alle bisher eingestellten Aufgaben fertig sind.
+ * @pre Darf nicht aus einer Aufgabe dieses Pools aufgerufen werden
+ */
+void ThreadPool::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    allDone.wait(lock, [this] { return tasks.empty() && running == 0; });
+}
+
+/**
+ * @brief Führt job(0) bis job(count - 1) parallel aus und wartet, bis alle fertig sind.
+ *
+ * Der aufrufende Thread arbeitet mit. Wartet nur auf diese Aufträge, nicht auf andere
+ * Aufgaben im Pool. Sind alle Arbeitsthreads belegt, erledigt der Aufrufer alles selbst.
+ *
+ * @param count Anzahl der Aufträge
+ * @param job wird für jeden Index genau einmal aufgerufen
+ */
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& job)
+{
+    if (count == 0) return;
+
+    struct Batch {
+        std::atomic<size_t> next{0};
+        size_t count = 0, done = 0;
+        std::function<void(size_t)> job;
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+
+    auto batch = std::make_shared<Batch>();
+    batch->count = count;
+    batch->job = job;
+
+    //Helfer, die erst nach dem Ende starten, finden keinen Index mehr und rufen job nicht auf
+    auto work = [batch] {
+        size_t index;
+        while ((index = batch->next++) < batch->count)
+        {
+            batch->job(index);
+
+            std::lock_guard<std::mutex> lock(batch->mutex);
+            if (++batch->done == batch->count)
+            {
+                batch->finished.notify_all();
+            }
+        }
+    };
+
+    size_t helpers = std::min(count - 1, workers.size());
+    for (size_t i = 0; i < helpers; ++i)
+    {
+        submit(work);
+    }
+
+    work();
+
+    std::unique_lock<std::mutex> lock(batch->mutex);
+    batch->finished.wait(lock, [&batch] { return batch->done == batch->count; });
+}
+
+///@brief Anzahl der Arbeitsthreads
+size_t ThreadPool::size() const
+{
+    return workers.size();
+}
+
+///@brief Anzahl der Hardware-Threads, mindestens 1
+size_t ThreadPool::hardwareThreads()
+{
+    unsigned int threads = std::thread::hardware_concurrency();
+    return threads == 0 ? 1 : threads;
+}
+
+///@brief Schleife eines Arbeitsthreads: Aufgabe holen, ausführen, bis der Pool beendet wird
+void ThreadPool::workerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (true)
+    {
+        taskReady.wait(lock, [this] { return stopping || !tasks.empty(); });
+
+        if (tasks.empty()) return; //stopping und nichts mehr zu tun
+
+        std::function<void()> task = std::move(tasks.front());
+        tasks.pop_front();
+        ++running;
+
+        lock.unlock();
+        task();
+        lock.lock();
+
+        --running;
+        if (tasks.empty() && running == 0)
+        {
+            allDone.notify_all();
+        }
+    }
+}
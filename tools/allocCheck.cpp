@@ -0,0 +1,138 @@
+#include "headers/map.h"
+#include "headers/player.h"
+#include "headers/renderer.h"
+#include "headers/ruleProfile.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fcntl.h>
+#include <iostream>
+#include <new>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+/**
+ * Prüft, dass ein Zug im Spiel keinen Speicher anfordert.
+ *
+ * Aufruf: allocCheck [KARTE] [EINGABEN]
+ *   KARTE     Name wie im Menü (Standard spiel.txt), aus maps/ oder eingebaut
+ *   EINGABEN  Zugfolge wie im Spiel (Standard DDDFDDDDDDDDDDDDDDFDDDDFDDAAF)
+ *
+ * Der globale operator new ist ersetzt und zählt pro Thread, die Ladethreads von Map
+ * zählen also nicht mit. Die Karte wird geladen und Player::reset() aufgerufen, das
+ * erste Bild wird gezeichnet. Danach zählt jeder Zug wie im Spiel:
+ * Player::updatePosition() und bei MOVED Renderer::drawFrame(). Gezeichnet wird in
+ * ein gedachtes Terminal (Ausschnitt und ganze Karte, Änderungsbilder) und ohne
+ * Terminal (ganze Bilder als Text), ausgegeben wird nichts.
+ *
+ * Rückgabe 0, wenn kein Zug Speicher anfordert; 1 bei falschen Argumenten, einer
+ * unbekannten oder ungültigen Karte oder wenn ein Zug Speicher anfordert.
+ */
+namespace {
+
+thread_local size_t allocations = 0;
+
+/**
+ * @class SilentTerminal
+ * @brief Renderer für ein Terminal fester Größe, das die Bilder verwirft.
+ */
+class SilentTerminal final : public Renderer {
+public:
+    SilentTerminal() : Renderer(24, 80) {}
+
+protected:
+    void output(const std::string&) override {}
+};
+
+/**
+ * @brief Spielt die Eingaben von der Startposition aus und zählt die Allokationen pro Zug.
+ * @param renderer bekommt wie im Spiel nach jedem Zug mit MOVED ein Bild
+ * @return Anzahl der Züge, die Speicher angefordert haben
+ */
+size_t playCounted(Map& map, Renderer& renderer, const std::string& inputs, const std::string& label)
+{
+    Player player(map);
+    player.reset();
+    renderer.invalidate();
+    renderer.drawFrame(map.getMap(), player.getState().x, player.getState().y);
+
+    size_t failures = 0;
+    for (size_t i = 0; i < inputs.size() && !player.isDead() && !player.hasWon(); ++i)
+    {
+        size_t before = allocations;
+
+        if (player.updatePosition(inputs[i]) == Physics::Outcome::MOVED)
+        {
+            renderer.drawFrame(map.getMap(), player.getState().x, player.getState().y);
+        }
+
+        size_t count = allocations - before;
+        if (count > 0)
+        {
+            std::cout << label << ": Zug " << i + 1 << " (" << inputs[i] << ") " << count << " Allokationen\n";
+            ++failures;
+        }
+    }
+    return failures;
+}
+
+}
+
+void* operator new(size_t size)
+{
+    ++allocations;
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc > 3)
+    {
+        std::cerr << "Aufruf: allocCheck [KARTE] [EINGABEN]\n";
+        return 1;
+    }
+
+    std::string name = argc > 1 ? argv[1] : "spiel.txt";
+    std::string inputs = argc > 2 ? argv[2] : "DDDFDDDDDDDDDDDDDDFDDDDFDDAAF";
+
+    Map map(1, RuleProfile::CLASSIC);
+    const std::vector<std::string>& names = map.getMapsNames();
+    auto found = std::find(names.begin(), names.end(), name);
+    if (found == names.end() || !map.selectMap(static_cast<size_t>(found - names.begin())))
+    {
+        std::cerr << "\n" << name << ": unbekannt oder ungültig\n";
+        return 1;
+    }
+    std::cout << "\n"; //Map schreibt beim Laden eine Meldung ohne Zeilenende
+
+    SilentTerminal camera;
+    SilentTerminal full;
+    full.setMode(Renderer::Mode::FULL);
+
+    int devNull = open("/dev/null", O_WRONLY | O_CLOEXEC);
+    Renderer text(devNull);
+
+    size_t failures = playCounted(map, camera, inputs, "Ausschnitt") + playCounted(map, full, inputs, "ganze Karte")
+                      + playCounted(map, text, inputs, "ohne Terminal");
+    close(devNull);
+
+    if (failures > 0)
+    {
+        std::cout << name << ": " << failures << " Züge mit Allokationen\n";
+        return 1;
+    }
+
+    std::cout << name << ": " << inputs.size() << " Züge je Ausgabe, 0 Allokationen\n";
+    return 0;
+}
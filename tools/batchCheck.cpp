@@ -0,0 +1,255 @@
+#include "headers/agentBatch.h"
+#include "headers/level.h"
+#include "headers/mapCache.h"
+#include "headers/ruleProfile.h"
+#include "headers/simulation.h"
+#include "headers/threadPool.h"
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * Vergleicht AgentBatch mit Simulation::run() auf allen Karten eines Ordners.
+ *
+ * Aufruf: batchCheck [ORDNER] [--seed N] [--agents N] [--threads N]
+ *   ORDNER     Kartenordner (Standard maps/), jede gültige .txt-Datei mit jedem Regelprofil
+ *   --seed     Startwert für die Eingabefolgen (Standard 1)
+ *   --agents   Spieler pro Karte (Standard 5000, ab AgentBatch::MIN_PARALLEL mit Threads)
+ *   --threads  Threads für den zweiten Durchlauf von AgentBatch (Standard 4)
+ *
+ * Die Eingabefolgen hängen nur vom Startwert ab, gleicher Startwert ergibt auf jedem
+ * Rechner dieselben Folgen: Spieler 0 spielt die kürzeste Lösung der Karte, die
+ * nächsten je eine Lösung mit einzelnen geänderten Zeichen, alle anderen Zufallsfolgen
+ * aus A, D, F, Leerraum, selten E und unbekannten Zeichen. Jede Folge wird einzeln mit
+ * Simulation::run() und alle zusammen mit AgentBatch abgespielt, einmal ohne und einmal
+ * mit Threads. Für jeden Spieler müssen Ende (gewonnen, tot), Position und Zahl der
+ * Züge übereinstimmen.
+ *
+ * Rückgabe 0, 1 bei falschen Argumenten, wenn keine Karte gültig ist oder bei einer Abweichung.
+ */
+namespace {
+
+namespace fs = std::filesystem;
+
+constexpr size_t SCRIPT_LENGTH = 300;
+
+///@brief Zufallszahlen, die auf jedem Rechner gleich sind (SplitMix64)
+class Random {
+public:
+    explicit Random(uint64_t seed) : value(seed) {}
+
+    uint64_t next()
+    {
+        uint64_t z = (value += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    size_t below(size_t bound) { return static_cast<size_t>(next() % bound); }
+
+private:
+    uint64_t value;
+};
+
+///@brief Ein zufälliges Zeichen, meist ein Zug, selten E oder etwas ohne Wirkung
+char randomInput(Random& random)
+{
+    static const char MOVES[] = "DDDDAAAFF";
+    static const char OTHERS[] = " \tEx";
+
+    if (random.below(50) != 0) return MOVES[random.below(sizeof(MOVES) - 1)];
+    return OTHERS[random.below(sizeof(OTHERS) - 1)];
+}
+
+/**
+ * @brief Die Eingabefolgen für eine Karte, siehe oben.
+ * @param seed Startwert, zusammen mit dem Namen der Karte
+ */
+std::vector<std::string> makeScripts(const Level& level, size_t agents, uint64_t seed)
+{
+    Random random(seed);
+    std::vector<std::string> scripts;
+    scripts.reserve(agents);
+
+    if (!level.solution.empty() && agents > 0) scripts.push_back(level.solution);
+
+    while (scripts.size() < agents && scripts.size() < 64 && !level.solution.empty())
+    {
+        std::string mutated = level.solution;
+        mutated[random.below(mutated.size())] = randomInput(random);
+        scripts.push_back(mutated);
+    }
+
+    while (scripts.size() < agents)
+    {
+        std::string script(SCRIPT_LENGTH, ' ');
+        for (char& input : script) input = randomInput(random);
+        scripts.push_back(script);
+    }
+    return scripts;
+}
+
+///@brief Seed pro Karte, damit jede Karte andere Folgen bekommt (FNV-1a über den Namen)
+uint64_t mapSeed(uint64_t seed, const std::string& name)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (char c : name)
+    {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+    }
+    return seed ^ hash;
+}
+
+/**
+ * @brief Spielt alle Folgen gleichzeitig mit AgentBatch und vergleicht mit den Einzelergebnissen.
+ * @return Anzahl der Spieler, die anders enden
+ */
+size_t compareBatch(const std::shared_ptr<const Level>& level, const std::vector<std::string>& scripts,
+                    const std::vector<SimulationResult>& expected, ThreadPool* pool, const std::string& label)
+{
+    size_t agents = scripts.size();
+    size_t ticks = 0;
+    for (const auto& script : scripts) ticks = std::max(ticks, script.size());
+
+    //Eingaben pro Takt hintereinander, kürzere Folgen mit Leerzeichen aufgefüllt
+    std::string inputs(ticks * agents, ' ');
+    for (size_t agent = 0; agent < agents; ++agent)
+    {
+        for (size_t tick = 0; tick < scripts[agent].size(); ++tick)
+        {
+            inputs[tick * agents + agent] = scripts[agent][tick];
+        }
+    }
+
+    AgentBatch batch(level, agents);
+    for (size_t tick = 0; tick < ticks && batch.running() > 0; ++tick)
+    {
+        batch.tick(inputs.data() + tick * agents, pool);
+    }
+
+    size_t mismatches = 0;
+    for (size_t agent = 0; agent < agents; ++agent)
+    {
+        const SimulationResult& result = expected[agent];
+        uint8_t state = batch.getState()[agent];
+
+        if (result.won != (state == AgentBatch::WON) || result.dead != (state == AgentBatch::DEAD)
+            || result.x != batch.getX()[agent] || result.y != batch.getY()[agent]
+            || result.steps != batch.getSteps()[agent])
+        {
+            if (mismatches++ < 5)
+            {
+                std::cout << "  Abweichung " << label << " bei Spieler " << agent << ": Batch " << batch.getX()[agent]
+                          << " x " << batch.getY()[agent] << " nach " << batch.getSteps()[agent]
+                          << " Zügen, einzeln " << result.x << " x " << result.y << " nach " << result.steps << "\n";
+            }
+        }
+    }
+    return mismatches;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    std::string directory = "maps/";
+    uint64_t seed = 1;
+    size_t agents = 5000, threads = 4;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+
+        try
+        {
+            if (argument == "--seed" && i + 1 < argc)
+            {
+                seed = std::stoull(argv[++i]);
+            } else if (argument == "--agents" && i + 1 < argc)
+            {
+                long value = std::stol(argv[++i]);
+                if (value < 1 || value > 10000000) throw std::out_of_range("agents");
+                agents = static_cast<size_t>(value);
+            } else if (argument == "--threads" && i + 1 < argc)
+            {
+                long value = std::stol(argv[++i]);
+                if (value < 2 || value > 1024) throw std::out_of_range("threads");
+                threads = static_cast<size_t>(value);
+            } else if (argument[0] != '-')
+            {
+                directory = argument;
+            } else {
+                std::cerr << "Aufruf: batchCheck [ORDNER] [--seed N] [--agents N] [--threads N]\n";
+                return 1;
+            }
+        }
+        catch (const std::logic_error&)
+        {
+            std::cerr << "Falsche Zahl für " << argument << "\n";
+            return 1;
+        }
+    }
+
+    std::vector<fs::path> paths;
+    std::error_code error;
+    for (fs::directory_iterator entry(directory, error), end; !error && entry != end; entry.increment(error))
+    {
+        if (entry->path().extension() == ".txt") paths.push_back(entry->path());
+    }
+    if (error)
+    {
+        std::cerr << directory << ": " << error.message() << "\n";
+        return 1;
+    }
+    std::sort(paths.begin(), paths.end());
+
+    ThreadPool pool(threads - 1);
+    size_t checked = 0, mismatches = 0;
+
+    for (const fs::path& path : paths)
+    {
+        for (RuleProfile rules : {RuleProfile::CLASSIC, RuleProfile::TALL})
+        {
+            std::string label = path.filename().string() + " (" + ruleProfileName(rules) + ")";
+
+            auto loaded = std::make_shared<Level>();
+            if (!MapCache::load(path.string(), *loaded, rules) && !Level::loadText(path.string(), *loaded, rules).ok())
+            {
+                std::cout << label << ": ungültig, übersprungen\n";
+                continue;
+            }
+            std::shared_ptr<const Level> level = loaded;
+
+            std::vector<std::string> scripts = makeScripts(*level, agents, mapSeed(seed, label));
+            std::vector<SimulationResult> expected(scripts.size());
+            size_t won = 0, dead = 0, steps = 0;
+            for (size_t i = 0; i < scripts.size(); ++i)
+            {
+                expected[i] = Simulation::run(*level, scripts[i]);
+                won += expected[i].won;
+                dead += expected[i].dead;
+                steps += expected[i].steps;
+            }
+
+            size_t differing = compareBatch(level, scripts, expected, nullptr, "ohne Threads")
+                               + compareBatch(level, scripts, expected, &pool, "mit Threads");
+
+            std::cout << label << ": " << scripts.size() << " Spieler, " << steps << " Züge, " << won
+                      << " gewonnen, " << dead << " tot, " << differing << " Abweichungen\n";
+
+            mismatches += differing;
+            ++checked;
+        }
+    }
+
+    if (checked == 0)
+    {
+        std::cerr << directory << ": keine gültige Karte\n";
+        return 1;
+    }
+    return mismatches == 0 ? 0 : 1;
+}
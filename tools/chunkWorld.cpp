@@ -0,0 +1,290 @@
+#include "headers/chunkedWorld.h"
+#include "headers/level.h"
+#include "headers/physicsRules.h"
+#include "headers/simulation.h"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * Übersetzt Karten, die nicht in den Speicher passen, in Blöcke (.achunk) und spielt darauf.
+ *
+ * Aufruf: chunkWorld convert KARTE [WELT] [--chunk N] [--rules PROFIL]
+ *         chunkWorld play WELT (EINGABEN | -f DATEI)... [--budget MB] [--no-prefetch] [--verify KARTE]
+ *   convert        KARTE.txt prüfen und als WELT speichern (Standard: KARTE mit Endung .achunk)
+ *   --chunk        Kantenlänge eines Blocks (Standard 256)
+ *   --rules        Spielregeln classic (Standard) oder tall, gelten danach auch für play
+ *   play           Eingabefolgen wie bei simulate ohne Ausgabe abspielen, Blöcke nach Bedarf laden
+ *   --budget       höchstens so viele MB an Blöcken im Speicher (Standard 64)
+ *   --no-prefetch  keine Blöcke in Laufrichtung vorausladen
+ *   --verify       jede Folge zusätzlich mit Simulation::run() auf der ganz geladenen KARTE
+ *                  abspielen und vergleichen (nur für Karten, die in den Speicher passen)
+ *
+ * Gibt für jede Folge den Endzustand aus, danach Züge pro Sekunde und die Zähler des
+ * Blockcaches. Rückgabe 0, 1 bei falschen Argumenten, einer ungültigen Karte oder einer Abweichung.
+ */
+namespace {
+
+///@brief Ausgabe wie beim Laden im Spiel, nur knapper
+void printReport(const std::string& path, const LoadReport& report)
+{
+    switch (report.status)
+    {
+        case LoadReport::Status::OPEN_FAILED:
+            std::cerr << path << ": Datei konnte nicht gelesen oder geschrieben werden\n";
+            break;
+        case LoadReport::Status::BAD_DIMENSION:
+            std::cerr << path << ": Höhe oder Breite ist ungültig\n";
+            break;
+        case LoadReport::Status::INVALID:
+            std::cerr << path << ": Karte ist ungültig (Zeile " << report.validation.errorRow + 1 << ", Spalte "
+                      << report.validation.errorCol + 1 << ")\n";
+            break;
+        case LoadReport::Status::UNREACHABLE:
+            std::cerr << path << ": Ziel ist nicht erreichbar\n";
+            break;
+        case LoadReport::Status::OUT_OF_MEMORY:
+            std::cerr << path << ": zu groß für den Speicher\n";
+            break;
+        case LoadReport::Status::OK:
+            break;
+    }
+}
+
+int convert(const std::vector<std::string>& arguments)
+{
+    std::string source, target;
+    size_t chunkSize = ChunkedWorld::DEFAULT_CHUNK;
+    RuleProfile rules = RuleProfile::CLASSIC;
+
+    for (size_t i = 0; i < arguments.size(); ++i)
+    {
+        if (arguments[i] == "--chunk" && i + 1 < arguments.size())
+        {
+            chunkSize = std::stoul(arguments[++i]);
+        } else if (arguments[i] == "--rules" && i + 1 < arguments.size())
+        {
+            if (!parseRuleProfile(arguments[++i], rules))
+            {
+                std::cerr << "Unbekannte Regeln: " << arguments[i] << "\n";
+                return 1;
+            }
+        } else if (source.empty())
+        {
+            source = arguments[i];
+        } else {
+            target = arguments[i];
+        }
+    }
+
+    if (source.empty() || chunkSize == 0)
+    {
+        std::cerr << "Aufruf: chunkWorld convert KARTE [WELT] [--chunk N] [--rules PROFIL]\n";
+        return 1;
+    }
+    if (target.empty())
+    {
+        size_t dot = source.rfind('.');
+        target = (dot == std::string::npos ? source : source.substr(0, dot)) + ChunkedWorld::EXTENSION;
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    LoadReport report = ChunkedWorld::convert(source, target, chunkSize, rules);
+    std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - begin;
+
+    if (!report.ok())
+    {
+        printReport(source, report);
+        return 1;
+    }
+
+    std::cout << source << " -> " << target << " in " << seconds.count() << " s\n";
+    return 0;
+}
+
+/**
+ * @brief Spielt eine Folge mit den Regeln Rules ab, ohne im Zug nach dem Profil zu fragen.
+ */
+template <typename Rules>
+SimulationResult play(const ChunkedWorld& world, const std::string& inputs, bool prefetch)
+{
+    PlayerState state;
+    state.y = world.getStartPos()[0];
+    state.x = world.getStartPos()[1];
+    SimulationResult result;
+
+    size_t ahead = world.getChunkSize() / 2;
+
+    for (char input : inputs)
+    {
+        if (input == ' ' || (input >= '\t' && input <= '\r')) continue;
+
+        ++result.steps;
+        PlayerState before = state;
+        PhysicsRules<ChunkedWorld, Rules>::scan(world, state, input);
+
+        if (state.dead) break;
+        if (state.y == world.getGoalPos()[0] && state.x == world.getGoalPos()[1])
+        {
+            result.won = true;
+            break;
+        }
+
+        //einen halben Block in Laufrichtung voraus, bei einem Fall oder Klettern nach oben bzw. unten
+        if (prefetch && (state.x != before.x || state.y != before.y))
+        {
+            size_t col = state.x, row = state.y;
+            if (state.x > before.x) col += ahead;
+            if (state.x < before.x) col = col > ahead ? col - ahead : 0;
+            if (state.y > before.y) row += ahead;
+            if (state.y < before.y) row = row > ahead ? row - ahead : 0;
+            world.prefetch(col, row);
+        }
+    }
+
+    result.dead = state.dead;
+    result.x = state.x;
+    result.y = state.y;
+
+    return result;
+}
+
+int play(const std::vector<std::string>& arguments)
+{
+    std::string path, reference;
+    std::vector<std::string> scripts;
+    size_t budgetMb = 64;
+    bool prefetch = true;
+
+    for (size_t i = 0; i < arguments.size(); ++i)
+    {
+        const std::string& argument = arguments[i];
+
+        if (argument == "-f" && i + 1 < arguments.size())
+        {
+            std::ifstream file(arguments[++i]);
+            if (!file)
+            {
+                std::cerr << "Datei konnte nicht geöffnet werden: " << arguments[i] << "\n";
+                return 1;
+            }
+            for (std::string line; std::getline(file, line);)
+            {
+                if (!line.empty()) scripts.push_back(line);
+            }
+        } else if (argument == "--budget" && i + 1 < arguments.size())
+        {
+            budgetMb = std::stoul(arguments[++i]);
+        } else if (argument == "--verify" && i + 1 < arguments.size())
+        {
+            reference = arguments[++i];
+        } else if (argument == "--no-prefetch")
+        {
+            prefetch = false;
+        } else if (path.empty())
+        {
+            path = argument;
+        } else {
+            scripts.push_back(argument);
+        }
+    }
+
+    if (path.empty() || scripts.empty())
+    {
+        std::cerr << "Aufruf: chunkWorld play WELT (EINGABEN | -f DATEI)... [--budget MB]\n";
+        return 1;
+    }
+
+    ChunkedWorld world(budgetMb << 20);
+    if (!world.open(path))
+    {
+        std::cerr << path << ": keine gültige " << ChunkedWorld::EXTENSION << "-Datei\n";
+        return 1;
+    }
+
+    std::vector<SimulationResult> results(scripts.size());
+    size_t totalSteps = 0;
+
+    auto begin = std::chrono::steady_clock::now();
+    withRules(world.getRules(), [&](auto rules) {
+        for (size_t i = 0; i < scripts.size(); ++i)
+        {
+            results[i] = play<decltype(rules)>(world, scripts[i], prefetch);
+            totalSteps += results[i].steps;
+        }
+    });
+    std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - begin;
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const SimulationResult& result = results[i];
+        const char* state = result.won ? "gewonnen" : (result.dead ? "tot" : "läuft noch");
+
+        std::cout << "[" << i + 1 << "] " << state << " nach " << result.steps << " Zügen, Position "
+                  << result.x << " x " << result.y << "\n";
+    }
+
+    ChunkedWorld::Stats stats = world.getStats();
+    double averageUs = stats.misses == 0 ? 0.0 : static_cast<double>(stats.missNsTotal) / static_cast<double>(stats.misses) / 1000.0;
+
+    std::cout << totalSteps << " Züge in " << seconds.count() << " s = "
+              << static_cast<double>(totalSteps) / seconds.count() << " Züge/s\n"
+              << "Blöcke: " << stats.hits << " Treffer, " << stats.misses << " nachgeladen (Ø " << averageUs
+              << " µs, max " << static_cast<double>(stats.missNsMax) / 1000.0 << " µs), " << stats.prefetched
+              << " vorausgeladen, " << stats.evicted << " verdrängt\n"
+              << "Speicher: " << static_cast<double>(stats.peakBytes) / (1 << 20) << " MB höchstens, Budget "
+              << budgetMb << " MB\n";
+
+    if (reference.empty()) return 0;
+
+    Level level;
+    LoadReport report = Level::loadText(reference, level, world.getRules());
+    if (report.status != LoadReport::Status::OK && report.status != LoadReport::Status::UNREACHABLE)
+    {
+        printReport(reference, report);
+        return 1;
+    }
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < scripts.size(); ++i)
+    {
+        SimulationResult expected = Simulation::run(level, scripts[i]);
+        const SimulationResult& result = results[i];
+
+        if (expected.won != result.won || expected.dead != result.dead || expected.x != result.x
+            || expected.y != result.y || expected.steps != result.steps)
+        {
+            std::cout << "Abweichung bei [" << i + 1 << "]: erwartet Position " << expected.x << " x " << expected.y
+                      << " nach " << expected.steps << " Zügen\n";
+            ++mismatches;
+        }
+    }
+
+    std::cout << "Vergleich mit " << reference << ": " << mismatches << " Abweichungen\n";
+    return mismatches == 0 ? 0 : 1;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> arguments(argv + (argc > 1 ? 2 : 1), argv + argc);
+    std::string command = argc > 1 ? argv[1] : "";
+
+    try
+    {
+        if (command == "convert") return convert(arguments);
+        if (command == "play") return play(arguments);
+    }
+    catch (const std::logic_error&)
+    {
+        std::cerr << "Falsche Zahl\n";
+        return 1;
+    }
+
+    std::cerr << "Aufruf: chunkWorld convert KARTE [WELT] [--chunk N] [--rules PROFIL]\n"
+                 "        chunkWorld play WELT (EINGABEN | -f DATEI)... [--budget MB] [--no-prefetch] [--verify KARTE]\n";
+    return 1;
+}
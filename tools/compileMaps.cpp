@@ -0,0 +1,67 @@
+#include "headers/level.h"
+#include "headers/mapCache.h"
+#include <filesystem>
+#include <iostream>
+
+namespace fs = std::filesystem;
+
+/**
+ * Übersetzt alle .txt-Karten eines Ordners vorab in .amap-Dateien, damit
+ * Map::selectMap() sie ohne Prüfung laden kann.
+ *
+ * Aufruf: compileMaps [Ordner] [--rules PROFIL]   (Standard maps/ und classic)
+ * Die .amap-Dateien gelten nur für das angegebene Regelprofil, wie es auch das Spiel
+ * mit --rules benutzt.
+ * Rückgabe 0, wenn alle Karten gültig sind, sonst 1.
+ */
+int main(int argc, char* argv[])
+{
+    std::string directory = "maps/";
+    RuleProfile rules = RuleProfile::CLASSIC;
+    bool allValid = true;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+        if (argument == "--rules" && i + 1 < argc)
+        {
+            if (!parseRuleProfile(argv[++i], rules))
+            {
+                std::cerr << "Unbekannte Regeln: " << argv[i] << "\n";
+                return 1;
+            }
+        } else {
+            directory = argument;
+        }
+    }
+
+    for (const auto& entry : fs::directory_iterator(directory))
+    {
+        if (!entry.is_regular_file() || entry.path().extension() != ".txt") continue;
+
+        std::string path = entry.path().string();
+        Level level;
+
+        if (MapCache::load(path, level, rules))
+        {
+            std::cout << path << ": aktuell\n";
+            continue;
+        }
+
+        LoadReport report = Level::loadText(path, level, rules);
+
+        if (!report.ok())
+        {
+            std::cout << path << ": ungültig, nicht übersetzt\n";
+            allValid = false;
+        } else if (MapCache::store(path, level))
+        {
+            std::cout << path << " -> " << MapCache::cachePath(path) << "\n";
+        } else {
+            std::cout << path << ": " << MapCache::cachePath(path) << " konnte nicht geschrieben werden\n";
+            allValid = false;
+        }
+    }
+
+    return allValid ? 0 : 1;
+}
@@ -0,0 +1,175 @@
+#include "headers/builtinMap.h"
+#include "headers/level.h"
+#include "headers/ruleProfile.h"
+#include <cctype>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+/**
+ * Erzeugt headers/builtinMaps.h: die angegebenen Karten als constexpr-Daten zum Einbauen.
+ *
+ * Aufruf: embedMaps [-o DATEI] KARTE...   (Standard: Ausgabe auf stdout)
+ *
+ * Jede Karte wird mit den Standardregeln (ClassicRules) geladen, geprüft und gelöst wie
+ * im Spiel, eine ungültige oder nicht lösbare Karte bricht ab. Die Datei enthält die unbereinigten Zeilen, ein static_assert
+ * mit StaticMapCheck prüft sie beim Übersetzen noch einmal mit den Regeln des Spiels,
+ * eine von Hand geänderte ungültige Karte lässt sich also nicht übersetzen.
+ * Rückgabe 0, 1 bei falschen Argumenten oder einer ungültigen Karte.
+ */
+namespace {
+
+/// Name für C++ aus dem Dateinamen, z.B. "spiel2.txt" -> "SPIEL2"
+std::string identifier(const std::string& path)
+{
+    std::string stem = fs::path(path).stem().string();
+    std::string name = std::isdigit(static_cast<unsigned char>(stem.empty() ? '0' : stem[0])) ? "MAP_" : "";
+
+    for (char c : stem)
+    {
+        name += std::isalnum(static_cast<unsigned char>(c)) ? static_cast<char>(std::toupper(c)) : '_';
+    }
+    return name;
+}
+
+/// Zeichen für ein C++-Zeichenkettenliteral, alles außer druckbarem ASCII oktal
+std::string escape(char cell)
+{
+    auto code = static_cast<unsigned char>(cell);
+    if (cell == '"' || cell == '\\' || code < 0x20 || code > 0x7E)
+    {
+        char octal[5];
+        std::snprintf(octal, sizeof(octal), "\\%03o", code);
+        return octal;
+    }
+    return std::string(1, cell);
+}
+
+/**
+ * @brief Schreibt eine Karte als constexpr-Daten.
+ * @return False, wenn die Karte ungültig ist oder StaticMapCheck anders urteilt als MapValidator
+ */
+bool embed(const std::string& path, std::ostream& out, std::ostream& table)
+{
+    Level level;
+    Grid source;
+    LoadReport report = Level::reloadText(path, nullptr, source, level, ClassicRules::PROFILE);
+
+    if (!report.ok())
+    {
+        std::cerr << path << ": ungültig oder nicht lösbar, wird nicht eingebaut\n";
+        return false;
+    }
+
+    size_t height = source.getHeight(), width = source.getWidth();
+    std::string cells;
+    for (size_t row = 0; row < height; ++row)
+    {
+        cells.append(source.row(row), width);
+    }
+
+    StaticMapCheck check = StaticMapCheck::run(cells, height, width, ClassicRules::MAX_SPACE,
+                                               ClassicRules::PLAYER_HEIGHT);
+    if (!check.ok() || check.startRow + 1 != level.startPos[0] || check.startCol != level.startPos[1]
+        || check.goalRow + 1 != level.goalPos[0] || check.goalCol != level.goalPos[1])
+    {
+        std::cerr << path << ": StaticMapCheck weicht von MapValidator ab\n";
+        return false;
+    }
+
+    std::string name = identifier(path);
+    std::string size = std::to_string(height) + ", " + std::to_string(width);
+
+    out << "inline constexpr std::string_view " << name << "_CELLS =\n";
+    for (size_t row = 0; row < height; ++row)
+    {
+        out << "        \"";
+        for (size_t col = 0; col < width; ++col)
+        {
+            out << escape(source(row, col));
+        }
+        out << "\"" << (row + 1 == height ? ";\n" : "\n");
+    }
+
+    out << "inline constexpr StaticMapCheck " << name << "_CHECK =\n"
+        << "        StaticMapCheck::run(" << name << "_CELLS, " << size
+        << ", ClassicRules::MAX_SPACE, ClassicRules::PLAYER_HEIGHT);\n"
+        << "static_assert(" << name << "_CHECK.ok(), \"" << path << " ist keine gültige Karte\");\n"
+        << "inline constexpr auto " << name << "_CLEANED = StaticMapCheck::cleanCells<" << height << " * " << width
+        << ">(" << name << "_CELLS);\n\n";
+
+    table << "        {\"" << fs::path(path).filename().string() << "\", " << size << ", builtin::" << name
+          << "_CELLS, {builtin::" << name << "_CLEANED.data(), builtin::" << name << "_CLEANED.size()},\n"
+          << "         builtin::" << name << "_CHECK,\n"
+          << "         \"" << level.solution << "\"},\n";
+
+    return true;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    std::string output;
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+        if (argument == "-o" && i + 1 < argc)
+        {
+            output = argv[++i];
+        } else {
+            paths.push_back(argument);
+        }
+    }
+
+    if (paths.empty())
+    {
+        std::cerr << "Aufruf: embedMaps [-o DATEI] KARTE...\n";
+        return 1;
+    }
+
+    std::ostringstream data, table;
+    for (const auto& path : paths)
+    {
+        if (!embed(path, data, table)) return 1;
+    }
+
+    std::ostringstream header;
+    header << "#ifndef PRUEFUNG_BUILTINMAPS_H\n"
+              "#define PRUEFUNG_BUILTINMAPS_H\n\n"
+              "//Erzeugt von tools/embedMaps, nicht von Hand ändern (siehe txt/COMPILE.txt).\n\n"
+              "#include <array>\n"
+              "#include <string_view>\n"
+              "#include \"headers/builtinMap.h\"\n"
+              "#include \"headers/ruleProfile.h\"\n\n"
+              "namespace builtin {\n\n"
+           << data.str()
+           << "}\n\n"
+              "/// alle eingebauten Karten, in der Reihenfolge für das Menü\n"
+              "inline constexpr std::array<BuiltinMap, " << paths.size() << "> BUILTIN_MAPS{{\n"
+           << table.str()
+           << "}};\n\n\n"
+              "#endif //PRUEFUNG_BUILTINMAPS_H\n";
+
+    if (output.empty())
+    {
+        std::cout << header.str();
+        return 0;
+    }
+
+    std::ofstream file(output, std::ios::trunc);
+    if (!(file << header.str()))
+    {
+        std::cerr << output << ": konnte nicht geschrieben werden\n";
+        return 1;
+    }
+    return 0;
+}
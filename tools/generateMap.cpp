@@ -0,0 +1,80 @@
+#include "headers/mapGenerator.h"
+#include <fstream>
+#include <iostream>
+#include <string>
+
+/**
+ * Erzeugt eine gültige Karte beliebiger Größe, deren Ziel erreichbar ist.
+ *
+ * Aufruf: generateMap BREITE HÖHE [--seed N] [--density D] [--ladders N] [--spacing 4|5] [-o DATEI]
+ *   --seed     gleicher Seed, gleiche Karte (Standard 1)
+ *   --density  Anteil fester Plattformzellen, 0 bis 1 (Standard 0.9)
+ *   --ladders  Leitern pro Ebene (Standard 2)
+ *   --spacing  Zeilen zwischen zwei Ebenen (Standard 4)
+ *   -o         Datei statt Standardausgabe
+ */
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+    {
+        std::cerr << "Aufruf: generateMap BREITE HÖHE [--seed N] [--density D] [--ladders N] [--spacing 4|5] [-o DATEI]\n";
+        return 1;
+    }
+
+    GeneratorOptions options;
+    std::string output;
+
+    try
+    {
+        options.width = std::stoul(argv[1]);
+        options.height = std::stoul(argv[2]);
+
+        for (int i = 3; i < argc; ++i)
+        {
+            std::string argument = argv[i];
+
+            if (i + 1 >= argc)
+            {
+                std::cerr << "Unbekannte Option: " << argument << "\n";
+                return 1;
+            }
+
+            if (argument == "--seed") options.seed = std::stoull(argv[++i]);
+            else if (argument == "--density") options.density = std::stod(argv[++i]);
+            else if (argument == "--ladders") options.laddersPerLayer = std::stoul(argv[++i]);
+            else if (argument == "--spacing") options.spacing = std::stoul(argv[++i]);
+            else if (argument == "-o") output = argv[++i];
+            else {
+                std::cerr << "Unbekannte Option: " << argument << "\n";
+                return 1;
+            }
+        }
+    }
+    catch (const std::logic_error&)
+    {
+        std::cerr << "Falsche Zahl\n";
+        return 1;
+    }
+
+    if (!MapGenerator::optionsValid(options))
+    {
+        std::cerr << "Ungültige Einstellungen: Breite >= 2, Höhe >= Abstand + 3, Abstand 4 oder 5, Dichte 0 bis 1\n";
+        return 1;
+    }
+
+    std::ios::sync_with_stdio(false);
+
+    if (output.empty())
+    {
+        return MapGenerator::write(std::cout, options) ? 0 : 1;
+    }
+
+    std::ofstream file(output, std::ios::binary | std::ios::trunc);
+    if (!MapGenerator::write(file, options))
+    {
+        std::cerr << output << " konnte nicht geschrieben werden\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,425 @@
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/**
+ * Lastgenerator für den Spielserver (tools/server): viele Sitzungen gleichzeitig,
+ * jede spielt zufällige Züge, gemessen werden Sitzungen pro Sekunde und die Latenz
+ * eines Zuges (senden bis Antwort gelesen).
+ *
+ * Aufruf: loadClient [--socket PFAD | --port N] [--sessions N] [--seconds S] [--moves N]
+ *                    [--map NAME] [--threads N]
+ *   --socket   Unix-Socket des Servers (Standard adventure.sock)
+ *   --port     statt dessen TCP auf 127.0.0.1
+ *   --sessions so viele Sitzungen sind immer gleichzeitig offen (Standard 10000)
+ *   --seconds  Dauer der Messung (Standard 10)
+ *   --moves    Züge pro Sitzung, danach wird sie geschlossen und eine neue geöffnet
+ *              (Standard 100); ist ein Spiel vorher vorbei, beginnt mit MAP ein neues
+ *   --map      Karte für alle Sitzungen (Standard spiel.txt)
+ *   --threads  Threads des Clients, die Sitzungen werden verteilt (Standard 1)
+ *
+ * Jede Sitzung hat immer genau einen Zug unterwegs, die Last ergibt sich also aus
+ * der Zahl der Sitzungen. Rückgabe 0, 1 bei falschen Argumenten oder wenn keine
+ * Sitzung zustande kam.
+ */
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// Ziel und Ablauf, für alle Threads gleich
+struct LoadOptions {
+    std::string socketPath = "adventure.sock";
+    long port = -1;
+    size_t sessions = 10000;
+    double seconds = 10;
+    size_t moves = 100;
+    std::string mapName = "spiel.txt";
+    size_t threads = 1;
+};
+
+/// Ergebnis eines Threads
+struct LoadResult {
+    size_t completed = 0, moves = 0, games = 0, errors = 0, peakOpen = 0;
+    std::vector<uint32_t> latencies; ///< Mikrosekunden pro Zug
+};
+
+/**
+ * @class LoadThread
+ * @brief Hält eine feste Zahl von Sitzungen offen und spielt darauf, mit einer epoll-Schleife.
+ */
+class LoadThread {
+public:
+    LoadThread(const LoadOptions& settings, size_t sessions, uint32_t firstSeed)
+            : options(settings), target(sessions), seed(firstSeed), epoll(epoll_create1(EPOLL_CLOEXEC))
+    {
+    }
+
+    ~LoadThread()
+    {
+        for (auto& entry : connections) close(entry.first);
+        if (epoll >= 0) close(epoll);
+    }
+
+    LoadThread(const LoadThread&) = delete;
+    LoadThread& operator=(const LoadThread&) = delete;
+
+    /**
+     * @brief Spielt bis zum Zeitpunkt end.
+     *
+     * Fehlende Sitzungen werden nachgeöffnet, höchstens OPEN_BATCH pro Runde, damit
+     * die Warteschlange des Servers nicht überläuft. Lehnt der Server ab (EAGAIN),
+     * wird es in der nächsten Runde wieder versucht.
+     */
+    void run(Clock::time_point end)
+    {
+        epoll_event events[256];
+
+        while (Clock::now() < end)
+        {
+            for (size_t opened = 0; connections.size() < target && opened < OPEN_BATCH; ++opened)
+            {
+                if (!open()) break;
+            }
+            result.peakOpen = std::max(result.peakOpen, connections.size());
+
+            int count = epoll_wait(epoll, events, 256, connections.size() < target ? 1 : 100);
+            for (int i = 0; i < count; ++i)
+            {
+                handle(events[i].data.fd, events[i].events);
+            }
+        }
+    }
+
+    LoadResult& getResult() { return result; }
+
+private:
+    static constexpr size_t OPEN_BATCH = 256;
+
+    enum class Phase { CONNECTING, MAP, MOVE };
+
+    struct Connection {
+        Phase phase = Phase::CONNECTING;
+        size_t movesLeft = 0;
+        Clock::time_point sent;
+        std::string input;
+    };
+
+    const LoadOptions& options;
+    size_t target;
+    uint32_t seed;
+    int epoll;
+    std::unordered_map<int, Connection> connections;
+    LoadResult result;
+
+    /**
+     * @brief Öffnet eine Sitzung, ohne auf den Verbindungsaufbau zu warten.
+     * @return False, wenn der Server gerade nichts annimmt oder ein Fehler auftrat
+     */
+    bool open()
+    {
+        bool tcp = options.port > 0;
+        int fd = socket(tcp ? AF_INET : AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0)
+        {
+            ++result.errors;
+            return false;
+        }
+
+        int connected;
+        if (tcp)
+        {
+            int on = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+
+            sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_port = htons(static_cast<uint16_t>(options.port));
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            connected = connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+        } else {
+            sockaddr_un address{};
+            address.sun_family = AF_UNIX;
+            std::strncpy(address.sun_path, options.socketPath.c_str(), sizeof(address.sun_path) - 1);
+            connected = connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+        }
+
+        if (connected != 0 && errno != EINPROGRESS)
+        {
+            if (errno != EAGAIN) ++result.errors; //EAGAIN: Warteschlange des Unix-Sockets voll
+            close(fd);
+            return false;
+        }
+
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLOUT;
+        event.data.fd = fd;
+        epoll_ctl(epoll, EPOLL_CTL_ADD, fd, &event);
+
+        Connection& connection = connections[fd];
+        connection.movesLeft = options.moves;
+        if (connected == 0) startGame(fd, connection);
+        return true;
+    }
+
+    ///@brief Verarbeitet ein Ereignis einer Sitzung
+    void handle(int fd, uint32_t events)
+    {
+        auto found = connections.find(fd);
+        if (found == connections.end()) return;
+        Connection& connection = found->second;
+
+        if (connection.phase == Phase::CONNECTING)
+        {
+            int error = 0;
+            socklen_t length = sizeof(error);
+            if (getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length) != 0 || error != 0)
+            {
+                fail(fd);
+                return;
+            }
+            startGame(fd, connection);
+            return;
+        }
+
+        if ((events & (EPOLLIN | EPOLLERR | EPOLLHUP)) == 0) return;
+
+        char buffer[4096];
+        ssize_t length = recv(fd, buffer, sizeof(buffer), 0);
+        if (length <= 0)
+        {
+            if (length < 0 && (errno == EAGAIN || errno == EINTR)) return;
+            fail(fd);
+            return;
+        }
+        connection.input.append(buffer, static_cast<size_t>(length));
+
+        size_t end;
+        while ((end = connection.input.find('\n')) != std::string::npos)
+        {
+            std::string line = connection.input.substr(0, end);
+            connection.input.erase(0, end + 1);
+
+            if (!answer(fd, connection, line)) return;
+        }
+    }
+
+    /**
+     * @brief Reagiert auf eine Antwort des Servers.
+     * @return False, wenn die Sitzung danach geschlossen ist
+     */
+    bool answer(int fd, Connection& connection, const std::string& line)
+    {
+        if (line.compare(0, 3, "ERR") == 0)
+        {
+            if (result.errors == 0) std::cerr << "Server: " << line << "\n";
+            fail(fd);
+            return false;
+        }
+
+        if (connection.phase == Phase::MAP)
+        {
+            connection.phase = Phase::MOVE;
+            return sendMove(fd, connection);
+        }
+
+        auto latency = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - connection.sent);
+        result.latencies.push_back(static_cast<uint32_t>(latency.count()));
+        ++result.moves;
+
+        if (--connection.movesLeft == 0)
+        {
+            ++result.completed;
+            finish(fd);
+            return false;
+        }
+
+        if (line.compare(0, 4, "DIED") == 0 || line.compare(0, 3, "WON") == 0 || line.compare(0, 4, "QUIT") == 0)
+        {
+            ++result.games;
+            startGame(fd, connection);
+            return connections.count(fd) != 0;
+        }
+
+        return sendMove(fd, connection);
+    }
+
+    ///@brief Wählt die Karte und wartet danach nur noch auf Antworten
+    void startGame(int fd, Connection& connection)
+    {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        epoll_ctl(epoll, EPOLL_CTL_MOD, fd, &event);
+
+        connection.phase = Phase::MAP;
+        send(fd, "MAP " + options.mapName + "\n");
+    }
+
+    ///@brief Schickt einen zufälligen Zug, wie in bench/benchSuite meist nach rechts
+    bool sendMove(int fd, Connection& connection)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        char move[2] = {"ADDDF"[(seed >> 16) % 5], '\n'};
+
+        connection.sent = Clock::now();
+        return send(fd, std::string(move, 2));
+    }
+
+    /**
+     * @brief Schreibt eine kurze Nachricht ganz oder gar nicht.
+     *
+     * Jede Sitzung hat höchstens eine Nachricht unterwegs, der Puffer des Sockets ist
+     * also immer leer genug; geht es doch nicht, zählt das als Fehler.
+     */
+    bool send(int fd, const std::string& message)
+    {
+        ssize_t written = ::send(fd, message.data(), message.size(), MSG_NOSIGNAL);
+        if (written != static_cast<ssize_t>(message.size()))
+        {
+            fail(fd);
+            return false;
+        }
+        return true;
+    }
+
+    void fail(int fd)
+    {
+        ++result.errors;
+        finish(fd);
+    }
+
+    void finish(int fd)
+    {
+        epoll_ctl(epoll, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+        connections.erase(fd);
+    }
+};
+
+///@brief Wert an der Stelle fraction (0..1) der sortierten Messwerte, in Millisekunden
+double percentile(const std::vector<uint32_t>& sorted, double fraction)
+{
+    if (sorted.empty()) return 0;
+    auto index = static_cast<size_t>(fraction * static_cast<double>(sorted.size() - 1));
+    return sorted[index] / 1000.0;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    LoadOptions options;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+
+        try
+        {
+            if (argument == "--socket" && i + 1 < argc)
+            {
+                options.socketPath = argv[++i];
+            } else if (argument == "--port" && i + 1 < argc)
+            {
+                options.port = std::stol(argv[++i]);
+                if (options.port < 1 || options.port > 65535) throw std::out_of_range("port");
+            } else if (argument == "--sessions" && i + 1 < argc)
+            {
+                options.sessions = std::max<size_t>(std::stoul(argv[++i]), 1);
+            } else if (argument == "--seconds" && i + 1 < argc)
+            {
+                options.seconds = std::stod(argv[++i]);
+            } else if (argument == "--moves" && i + 1 < argc)
+            {
+                options.moves = std::max<size_t>(std::stoul(argv[++i]), 1);
+            } else if (argument == "--map" && i + 1 < argc)
+            {
+                options.mapName = argv[++i];
+            } else if (argument == "--threads" && i + 1 < argc)
+            {
+                options.threads = std::max<size_t>(std::stoul(argv[++i]), 1);
+            } else {
+                std::cerr << "Aufruf: loadClient [--socket PFAD | --port N] [--sessions N] [--seconds S] [--moves N]\n"
+                             "                  [--map NAME] [--threads N]\n";
+                return 1;
+            }
+        }
+        catch (const std::logic_error&)
+        {
+            std::cerr << "Falsche Zahl für " << argument << "\n";
+            return 1;
+        }
+    }
+
+    rlimit files{};
+    if (getrlimit(RLIMIT_NOFILE, &files) == 0 && files.rlim_cur < files.rlim_max)
+    {
+        files.rlim_cur = files.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &files);
+    }
+    if (files.rlim_cur < options.sessions + 64)
+    {
+        std::cerr << "Warnung: nur " << files.rlim_cur << " Dateideskriptoren für " << options.sessions
+                  << " Sitzungen (ulimit -n)\n";
+    }
+
+    options.threads = std::min(options.threads, options.sessions);
+
+    std::vector<std::unique_ptr<LoadThread>> loads;
+    for (size_t i = 0; i < options.threads; ++i)
+    {
+        size_t share = options.sessions / options.threads + (i < options.sessions % options.threads ? 1 : 0);
+        loads.push_back(std::make_unique<LoadThread>(options, share, static_cast<uint32_t>(12345 + i)));
+    }
+
+    auto begin = Clock::now();
+    auto end = begin + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.seconds));
+
+    std::vector<std::thread> threads;
+    for (auto& load : loads)
+    {
+        threads.emplace_back([&load, end] { load->run(end); });
+    }
+    for (auto& thread : threads) thread.join();
+
+    std::chrono::duration<double> elapsed = Clock::now() - begin;
+
+    LoadResult total;
+    for (auto& load : loads)
+    {
+        LoadResult& result = load->getResult();
+        total.completed += result.completed;
+        total.moves += result.moves;
+        total.games += result.games;
+        total.errors += result.errors;
+        total.peakOpen += result.peakOpen;
+        total.latencies.insert(total.latencies.end(), result.latencies.begin(), result.latencies.end());
+    }
+    std::sort(total.latencies.begin(), total.latencies.end());
+
+    double seconds = elapsed.count();
+    std::cout << "Sitzungen: " << total.completed << " abgeschlossen in " << seconds << " s, "
+              << static_cast<double>(total.completed) / seconds << " pro Sekunde, höchstens " << total.peakOpen << " gleichzeitig\n"
+              << "Züge: " << total.moves << ", " << static_cast<double>(total.moves) / seconds << " pro Sekunde, " << total.games
+              << " Spiele zu Ende\n"
+              << "Latenz pro Zug: p50 " << percentile(total.latencies, 0.5) << " ms, p99 "
+              << percentile(total.latencies, 0.99) << " ms, max " << percentile(total.latencies, 1.0) << " ms\n"
+              << "Fehler: " << total.errors << "\n";
+
+    return total.moves > 0 ? 0 : 1;
+}
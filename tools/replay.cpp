@@ -0,0 +1,245 @@
+#include "headers/captureRenderer.h"
+#include "headers/inputLog.h"
+#include "headers/level.h"
+#include "headers/mapCache.h"
+#include "headers/physics.h"
+#include "headers/renderer.h"
+#include "headers/simulation.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+/**
+ * Spielt aufgezeichnete Spiele (.alog, siehe InputLog) nach und prüft den Endzustand.
+ *
+ * Aufruf: replay (AUFZEICHNUNG | ORDNER)... [--maps ORDNER] [--realtime] [--repeat N]
+ *         replay --cast DATEI
+ *   ORDNER      alle .alog-Dateien darin abspielen
+ *   --maps      Ordner mit den Karten (Standard maps/)
+ *   --realtime  jedes Spiel in der aufgenommenen Geschwindigkeit im Terminal zeigen
+ *   --repeat    ohne Ausgabe alle Spiele N-mal abspielen, für die Zeitmessung (Standard 1)
+ *   --cast      eine Aufnahme der Bilder (adventure --capture) im Terminal abspielen,
+ *               ohne Karte und ohne Spielregeln
+ *
+ * Ohne --realtime wird nichts gezeichnet und so schnell wie möglich gespielt, das
+ * ganze Archiv ist so ein Regressionstest für die Spielregeln. Eine Aufzeichnung
+ * gilt als abweichend, wenn sich die Karte geändert hat (Hash), der Start anders
+ * ist oder das Spiel anders endet als aufgenommen.
+ *
+ * Rückgabe 0, 1 bei falschen Argumenten, unlesbaren Aufzeichnungen oder Abweichungen.
+ */
+namespace {
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief Zeigt ein Spiel in der aufgenommenen Geschwindigkeit.
+ *
+ * Die Eingaben einer Folge werden gleichmäßig über ihre Dauer verteilt.
+ */
+void showRealtime(const std::shared_ptr<const Level>& level, const InputLog& log)
+{
+    Renderer renderer(STDOUT_FILENO);
+    renderer.setPlayerHeight(limitsOf(level->rules).playerHeight);
+    std::shared_ptr<const Grid> grid(level, &level->grid);
+
+    PlayerState state = Physics::start(*level);
+    renderer.drawFrame(grid, state.x, state.y);
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (const InputRun& run : log.runs)
+    {
+        for (uint32_t i = 0; i < run.count; ++i)
+        {
+            uint32_t offset = run.count > 1 ? static_cast<uint32_t>(uint64_t{run.durationMs} * i / (run.count - 1)) : 0;
+            std::this_thread::sleep_until(start + std::chrono::milliseconds(run.startMs + offset));
+
+            if (Physics::step(*level, state, run.input) == Physics::Outcome::MOVED)
+            {
+                renderer.drawFrame(grid, state.x, state.y);
+            }
+            if (state.dead || Physics::hasWon(*level, state)) return;
+        }
+    }
+}
+
+///@brief Beschreibt einen Endzustand, z.B. "gewonnen nach 27 Zügen, Position 20 x 9"
+std::string describe(const SimulationResult& result)
+{
+    return std::string(result.won ? "gewonnen" : (result.dead ? "tot" : "läuft noch")) + " nach "
+           + std::to_string(result.steps) + " Zügen, Position " + std::to_string(result.x) + " x "
+           + std::to_string(result.y);
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> logPaths;
+    std::string mapDirectory = "maps/";
+    size_t repeat = 1;
+    bool realtime = false;
+    std::string castPath;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+
+        try
+        {
+            if (argument == "--maps" && i + 1 < argc)
+            {
+                mapDirectory = argv[++i];
+            } else if (argument == "--repeat" && i + 1 < argc)
+            {
+                repeat = std::max<size_t>(std::stoul(argv[++i]), 1);
+            } else if (argument == "--realtime")
+            {
+                realtime = true;
+            } else if (argument == "--cast" && i + 1 < argc)
+            {
+                castPath = argv[++i];
+            } else if (fs::is_directory(argument))
+            {
+                std::vector<std::string> found;
+                for (const auto& entry : fs::directory_iterator(argument))
+                {
+                    if (entry.is_regular_file() && entry.path().extension() == InputLog::EXTENSION)
+                    {
+                        found.push_back(entry.path().string());
+                    }
+                }
+                std::sort(found.begin(), found.end());
+                logPaths.insert(logPaths.end(), found.begin(), found.end());
+            } else {
+                logPaths.push_back(argument);
+            }
+        }
+        catch (const std::logic_error&)
+        {
+            std::cerr << "Falsche Zahl für " << argument << "\n";
+            return 1;
+        }
+    }
+
+    if (!castPath.empty())
+    {
+        if (CaptureRenderer::play(castPath, STDOUT_FILENO)) return 0;
+
+        std::cerr << castPath << ": keine lesbare Aufnahme\n";
+        return 1;
+    }
+
+    if (logPaths.empty())
+    {
+        std::cerr << "Aufruf: replay (AUFZEICHNUNG | ORDNER)... [--maps ORDNER] [--realtime] [--repeat N]\n"
+                     "       replay --cast DATEI\n";
+        return 1;
+    }
+
+    std::map<std::string, std::shared_ptr<const Level>> levels; //jede Karte nur einmal pro Regelprofil laden
+    std::vector<InputLog> logs;
+    std::vector<std::shared_ptr<const Level>> logLevels;
+    size_t failures = 0;
+
+    for (const std::string& path : logPaths)
+    {
+        InputLog log;
+        if (!InputLog::read(path, log))
+        {
+            std::cout << path << ": nicht lesbar\n";
+            ++failures;
+            continue;
+        }
+
+        std::string key = log.mapName + "/" + ruleProfileName(log.rules);
+        auto found = levels.find(key);
+        if (found == levels.end())
+        {
+            auto loaded = std::make_shared<Level>();
+            std::string mapPath = mapDirectory + log.mapName;
+
+            if (!MapCache::load(mapPath, *loaded, log.rules) && !Level::loadText(mapPath, *loaded, log.rules).ok())
+            {
+                loaded.reset();
+            }
+            found = levels.emplace(key, loaded).first;
+        }
+
+        const std::shared_ptr<const Level>& level = found->second;
+        if (!level)
+        {
+            std::cout << path << ": Karte " << log.mapName << " fehlt oder ist ungültig\n";
+            ++failures;
+            continue;
+        }
+
+        PlayerState start = Physics::start(*level);
+        if (InputLog::hashLevel(*level) != log.mapHash)
+        {
+            std::cout << path << ": Karte " << log.mapName << " hat sich geändert\n";
+            ++failures;
+            continue;
+        }
+        if (start.x != log.startX || start.y != log.startY)
+        {
+            std::cout << path << ": anderer Start " << start.x << " x " << start.y << ", aufgenommen "
+                      << log.startX << " x " << log.startY << "\n";
+            ++failures;
+            continue;
+        }
+
+        if (realtime)
+        {
+            showRealtime(level, log);
+        }
+
+        logs.push_back(std::move(log));
+        logLevels.push_back(level);
+    }
+
+    std::vector<std::string> inputs;
+    for (const InputLog& log : logs) inputs.push_back(log.inputs());
+
+    std::vector<SimulationResult> results(logs.size());
+    size_t totalSteps = 0;
+
+    auto begin = std::chrono::steady_clock::now();
+    for (size_t round = 0; round < repeat; ++round)
+    {
+        for (size_t i = 0; i < logs.size(); ++i)
+        {
+            results[i] = Simulation::run(*logLevels[i], inputs[i]);
+            totalSteps += results[i].steps;
+        }
+    }
+    std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - begin;
+
+    for (size_t i = 0; i < logs.size(); ++i)
+    {
+        const SimulationResult& expected = logs[i].end;
+        const SimulationResult& result = results[i];
+
+        if (result.won != expected.won || result.dead != expected.dead || result.x != expected.x
+            || result.y != expected.y || result.steps != expected.steps)
+        {
+            std::cout << "Abweichung " << logs[i].mapName << ": " << describe(result) << ", aufgenommen "
+                      << describe(expected) << "\n";
+            ++failures;
+        }
+    }
+
+    std::cout << logPaths.size() << " Aufzeichnungen, " << failures << " Abweichungen, " << totalSteps
+              << " Züge in " << seconds.count() << " s = " << static_cast<double>(totalSteps) / seconds.count()
+              << " Züge/s\n";
+
+    return failures == 0 ? 0 : 1;
+}
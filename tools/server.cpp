@@ -0,0 +1,114 @@
+#include "headers/gameServer.h"
+#include "headers/levelCache.h"
+#include "headers/ruleProfile.h"
+#include "headers/threadPool.h"
+#include <csignal>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <sys/resource.h>
+
+/**
+ * Spielserver für viele Spieler gleichzeitig über einen lokalen Socket (siehe GameServer).
+ *
+ * Aufruf: server [--socket PFAD | --port N] [--threads N] [--maps ORDNER] [--rules PROFIL]
+ *   --socket  Unix-Socket (Standard adventure.sock)
+ *   --port    statt dessen TCP auf 127.0.0.1
+ *   --threads Arbeitsthreads (0 = einer pro Hardware-Thread, Standard 0)
+ *   --maps    Ordner mit den Karten (Standard maps/), eingebaute Karten gibt es immer
+ *   --rules   Spielregeln classic (Standard) oder tall
+ *
+ * Läuft bis SIGINT oder SIGTERM und gibt dann die Zähler aus. Ausprobieren z.B. mit
+ * "socat - UNIX-CONNECT:adventure.sock", Last erzeugen mit tools/loadClient.
+ * Rückgabe 0, 1 bei falschen Argumenten oder wenn der Socket nicht geöffnet werden kann.
+ */
+int main(int argc, char* argv[])
+{
+    std::string socketPath = "adventure.sock";
+    std::string mapDirectory = "maps/";
+    long port = -1;
+    size_t threads = 0;
+    RuleProfile rules = RuleProfile::CLASSIC;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+
+        try
+        {
+            if (argument == "--socket" && i + 1 < argc)
+            {
+                socketPath = argv[++i];
+            } else if (argument == "--port" && i + 1 < argc)
+            {
+                port = std::stol(argv[++i]);
+                if (port < 1 || port > 65535) throw std::out_of_range("port");
+            } else if (argument == "--threads" && i + 1 < argc)
+            {
+                threads = std::stoul(argv[++i]);
+            } else if (argument == "--maps" && i + 1 < argc)
+            {
+                mapDirectory = argv[++i];
+                if (mapDirectory.back() != '/') mapDirectory += '/';
+            } else if (argument == "--rules" && i + 1 < argc)
+            {
+                if (!parseRuleProfile(argv[++i], rules))
+                {
+                    std::cerr << "Unbekannte Regeln: " << argv[i] << " (classic oder tall)\n";
+                    return 1;
+                }
+            } else {
+                std::cerr << "Aufruf: server [--socket PFAD | --port N] [--threads N] [--maps ORDNER] [--rules PROFIL]\n";
+                return 1;
+            }
+        }
+        catch (const std::logic_error&)
+        {
+            std::cerr << "Falsche Zahl für " << argument << "\n";
+            return 1;
+        }
+    }
+
+    //eine Verbindung ist ein Dateideskriptor, für 10000 Sitzungen reicht die Voreinstellung (1024) nicht
+    rlimit files{};
+    if (getrlimit(RLIMIT_NOFILE, &files) == 0 && files.rlim_cur < files.rlim_max)
+    {
+        files.rlim_cur = files.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &files);
+    }
+
+    //Signale nur in diesem Thread mit sigwait() annehmen, auch die Arbeitsthreads erben die Maske
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    LevelCache levels(mapDirectory, rules);
+    GameServer server(levels, threads);
+
+    bool listening = port > 0 ? server.listenTcp(static_cast<uint16_t>(port)) : server.listenUnix(socketPath);
+    if (!listening)
+    {
+        std::cerr << (port > 0 ? "127.0.0.1:" + std::to_string(port) : socketPath) << " konnte nicht geöffnet werden\n";
+        return 1;
+    }
+
+    std::cout << "Server auf " << (port > 0 ? "127.0.0.1:" + std::to_string(port) : socketPath) << ", "
+              << (threads == 0 ? ThreadPool::hardwareThreads() : threads) << " Threads, Regeln "
+              << ruleProfileName(rules) << std::endl;
+
+    std::thread serving(&GameServer::run, &server);
+
+    int received = 0;
+    sigwait(&signals, &received);
+
+    server.stop();
+    serving.join();
+
+    GameServer::Stats stats = server.getStats();
+    std::cout << "Beendet: " << stats.accepted << " Verbindungen, " << stats.moves << " Züge, "
+              << levels.size() << " Karten geladen\n";
+
+    return 0;
+}
@@ -0,0 +1,195 @@
+#include "headers/agentBatch.h"
+#include "headers/level.h"
+#include "headers/mapCache.h"
+#include "headers/simulation.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * Spielt Eingabefolgen auf einer Karte ohne Ausgabe ab und misst den Durchsatz.
+ *
+ * Aufruf: simulate KARTE EINGABEN [--repeat N] [--batch] [--threads N] [--rules PROFIL]
+ *         simulate KARTE -f DATEI [--repeat N] [--batch] [--threads N] [--rules PROFIL]
+ *   EINGABEN  z.B. DDDFAAD, wie im Spiel
+ *   -f DATEI  eine Eingabefolge pro Zeile
+ *   --repeat  alle Folgen N-mal abspielen, für die Zeitmessung (Standard 1)
+ *   --batch   alle Folgen zusätzlich gleichzeitig mit AgentBatch abspielen und
+ *             Spieler für Spieler mit dem Ergebnis von Simulation::run() vergleichen
+ *   --threads Threads für AgentBatch (0 = alle Hardware-Threads, Standard 1)
+ *   --rules   Spielregeln classic (Standard) oder tall
+ *
+ * Gibt für jede Folge den Endzustand aus, danach Züge pro Sekunde.
+ * Rückgabe 0, 1 bei falschen Argumenten, einer ungültigen Karte oder einer Abweichung.
+ */
+namespace {
+
+/**
+ * @brief Spielt alle Folgen gleichzeitig mit AgentBatch ab und vergleicht mit den Einzelergebnissen.
+ * @return 0, wenn jeder Spieler genau so endet wie in Simulation::run(), sonst 1
+ */
+int runBatch(const std::shared_ptr<const Level>& level, const std::vector<std::string>& scripts,
+             const std::vector<SimulationResult>& expected, size_t repeat, size_t threads)
+{
+    size_t agents = scripts.size();
+    size_t ticks = 0;
+    for (const auto& script : scripts) ticks = std::max(ticks, script.size());
+
+    //Eingaben pro Takt hintereinander, kürzere Folgen mit Leerzeichen aufgefüllt
+    std::string inputs(ticks * agents, ' ');
+    for (size_t agent = 0; agent < agents; ++agent)
+    {
+        for (size_t tick = 0; tick < scripts[agent].size(); ++tick)
+        {
+            inputs[tick * agents + agent] = scripts[agent][tick];
+        }
+    }
+
+    if (threads == 0) threads = ThreadPool::hardwareThreads();
+    std::unique_ptr<ThreadPool> pool;
+    if (threads > 1) pool = std::make_unique<ThreadPool>(threads - 1);
+
+    AgentBatch batch(level, agents);
+    size_t totalSteps = 0;
+
+    auto begin = std::chrono::steady_clock::now();
+    for (size_t round = 0; round < repeat; ++round)
+    {
+        batch.reset();
+        for (size_t tick = 0; tick < ticks && batch.running() > 0; ++tick)
+        {
+            batch.tick(inputs.data() + tick * agents, pool.get());
+        }
+        for (uint32_t steps : batch.getSteps()) totalSteps += steps;
+    }
+    std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - begin;
+
+    size_t mismatches = 0;
+    for (size_t agent = 0; agent < agents; ++agent)
+    {
+        const SimulationResult& result = expected[agent];
+        uint8_t state = batch.getState()[agent];
+
+        if (result.won != (state == AgentBatch::WON) || result.dead != (state == AgentBatch::DEAD)
+            || result.x != batch.getX()[agent] || result.y != batch.getY()[agent]
+            || result.steps != batch.getSteps()[agent])
+        {
+            if (mismatches++ < 10)
+            {
+                std::cout << "Abweichung bei [" << agent + 1 << "]: Position " << batch.getX()[agent] << " x "
+                          << batch.getY()[agent] << ", " << batch.getSteps()[agent] << " Züge\n";
+            }
+        }
+    }
+
+    std::cout << "Batch: " << agents << " Spieler, " << totalSteps << " Züge in " << seconds.count() << " s = "
+              << static_cast<double>(totalSteps) / seconds.count() << " Züge/s, " << mismatches << " Abweichungen\n";
+
+    return mismatches == 0 ? 0 : 1;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+    {
+        std::cerr << "Aufruf: simulate KARTE (EINGABEN | -f DATEI) [--repeat N]\n";
+        return 1;
+    }
+
+    std::string path = argv[1];
+    std::vector<std::string> scripts;
+    size_t repeat = 1, threads = 1;
+    bool batch = false;
+    RuleProfile rules = RuleProfile::CLASSIC;
+
+    for (int i = 2; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+
+        try
+        {
+            if (argument == "-f" && i + 1 < argc)
+            {
+                std::ifstream file(argv[++i]);
+                if (!file)
+                {
+                    std::cerr << "Datei konnte nicht geöffnet werden: " << argv[i] << "\n";
+                    return 1;
+                }
+                for (std::string line; std::getline(file, line);)
+                {
+                    if (!line.empty()) scripts.push_back(line);
+                }
+            } else if (argument == "--repeat" && i + 1 < argc)
+            {
+                repeat = std::stoul(argv[++i]);
+            } else if (argument == "--threads" && i + 1 < argc)
+            {
+                threads = std::stoul(argv[++i]);
+            } else if (argument == "--batch")
+            {
+                batch = true;
+            } else if (argument == "--rules" && i + 1 < argc)
+            {
+                if (!parseRuleProfile(argv[++i], rules))
+                {
+                    std::cerr << "Unbekannte Regeln: " << argv[i] << "\n";
+                    return 1;
+                }
+            } else {
+                scripts.push_back(argument);
+            }
+        }
+        catch (const std::logic_error&)
+        {
+            std::cerr << "Falsche Zahl für " << argument << "\n";
+            return 1;
+        }
+    }
+
+    auto loaded = std::make_shared<Level>();
+    const Level& level = *loaded;
+    if (!MapCache::load(path, *loaded, rules))
+    {
+        LoadReport report = Level::loadText(path, *loaded, rules);
+        if (!report.ok())
+        {
+            std::cerr << path << ": Karte ist ungültig\n";
+            return 1;
+        }
+    }
+
+    std::vector<SimulationResult> results(scripts.size());
+    size_t totalSteps = 0;
+
+    auto begin = std::chrono::steady_clock::now();
+    for (size_t round = 0; round < repeat; ++round)
+    {
+        for (size_t i = 0; i < scripts.size(); ++i)
+        {
+            results[i] = Simulation::run(level, scripts[i]);
+            totalSteps += results[i].steps;
+        }
+    }
+    std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - begin;
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const SimulationResult& result = results[i];
+        const char* state = result.won ? "gewonnen" : (result.dead ? "tot" : "läuft noch");
+
+        std::cout << "[" << i + 1 << "] " << state << " nach " << result.steps << " Zügen, Position "
+                  << result.x << " x " << result.y << "\n";
+    }
+
+    std::cout << totalSteps << " Züge in " << seconds.count() << " s = "
+              << static_cast<double>(totalSteps) / seconds.count() << " Züge/s\n";
+
+    return batch ? runBatch(loaded, scripts, results, repeat, threads) : 0;
+}
@@ -0,0 +1,188 @@
+#include "headers/transitionTable.h"
+#include "headers/level.h"
+#include "headers/physics.h"
+#include "headers/profiler.h"
+#include <algorithm>
+#include <functional>
+
+namespace {
+
+/**
+ * @brief Teilt die Spalten in Bereiche auf und ruft job(erste, hinter letzter) für jeden auf.
+ *
+ * Kleine Karten (weniger als minParallel Zellen) berechnet der aufrufende Thread allein.
+ */
+void forColumnRanges(size_t width, size_t cells, ThreadPool* pool, size_t minParallel,
+                     const std::function<void(size_t, size_t)>& job)
+{
+    size_t ranges = (pool != nullptr && cells >= minParallel) ? std::min(pool->size() + 1, width) : 1;
+
+    if (ranges == 1)
+    {
+        job(0, width);
+    } else {
+        pool->parallelFor(ranges, [&](size_t range) {
+            job(width * range / ranges, width * (range + 1) / ranges);
+        });
+    }
+}
+
+}
+
+/**
+ * @brief Berechnet die Tabelle für eine Karte mit fertigem Plattformindex.
+ *
+ * Für jede Zelle werden die drei Eingaben einmal mit den Regeln aus level.rules ausgeführt.
+ * Mit einem ThreadPool werden die Spalten in Bereiche aufgeteilt.
+ *
+ * @param level Karte mit Plattformindex
+ * @param pool Threads oder nullptr
+ */
+void TransitionTable::build(const Level& level, ThreadPool* pool)
+{
+    PROFILE_SCOPE("level.transitions");
+
+    size_t cells = level.platforms.getRows().size();
+    targets.assign(cells * INPUTS, STAY);
+    columns.resize(cells);
+
+    withRules(level.rules, [&](auto rules) {
+        using Rules = decltype(rules);
+
+        forColumnRanges(level.grid.getWidth(), cells, pool, MIN_PARALLEL, [&](size_t firstCol, size_t lastCol) {
+            for (size_t col = firstCol; col < lastCol; ++col)
+            {
+                scanColumn<Rules>(level, col);
+            }
+        });
+    });
+}
+
+/**
+ * @brief Berechnet die Tabelle für eine geänderte Karte aus der Tabelle der vorherigen Fassung.
+ *
+ * Neu berechnet werden nur Spalten, die in einem geänderten Block liegen oder daneben.
+ * In allen anderen Spalten sind die Plattformen und ihre Nachbarspalten gleich geblieben,
+ * die Einträge werden kopiert und nur auf die neuen Zellnummern umgerechnet.
+ *
+ * @param level geänderte Karte mit Plattformindex
+ * @param previous vorherige Fassung mit Tabelle, gleich hoch und breit, mit denselben Regeln
+ * @param dirtyBlocks pro Block zu Grid::ALIGNMENT Spalten ungleich 0, wenn er sich geändert hat
+ * @param pool Threads oder nullptr
+ */
+void TransitionTable::update(const Level& level, const Level& previous, const std::vector<uint8_t>& dirtyBlocks,
+                             ThreadPool* pool)
+{
+    PROFILE_SCOPE("level.transitions");
+
+    size_t width = level.grid.getWidth();
+    size_t cells = level.platforms.getRows().size();
+    targets.assign(cells * INPUTS, STAY);
+    columns.resize(cells);
+
+    auto changed = [&dirtyBlocks](size_t col) { return dirtyBlocks[col / Grid::ALIGNMENT] != 0; };
+
+    withRules(level.rules, [&](auto rules) {
+        using Rules = decltype(rules);
+
+        forColumnRanges(width, cells, pool, MIN_PARALLEL, [&](size_t firstCol, size_t lastCol) {
+            for (size_t col = firstCol; col < lastCol; ++col)
+            {
+                if (changed(col) || (col > 0 && changed(col - 1)) || (col + 1 < width && changed(col + 1)))
+                {
+                    scanColumn<Rules>(level, col);
+                } else {
+                    copyColumn(level, previous, col);
+                }
+            }
+        });
+    });
+}
+
+/**
+ * @brief Führt für jede Plattformzelle einer Spalte die drei Eingaben mit Physics::scanWith() aus.
+ */
+template <typename Rules>
+void TransitionTable::scanColumn(const Level& level, size_t col)
+{
+    const PlatformIndex& platforms = level.platforms;
+    const auto& offsets = platforms.getOffsets();
+    const auto& rows = platforms.getRows();
+
+    for (size_t cell = offsets[col]; cell < offsets[col + 1]; ++cell)
+    {
+        columns[cell] = static_cast<uint32_t>(col);
+
+        PlayerState from;
+        from.x = col;
+        from.y = rows[cell] - 1;
+
+        for (char input : {'A', 'D', 'F'})
+        {
+            PlayerState to = from;
+            uint32_t& target = targets[cell * INPUTS + slot(input)];
+
+            switch (Physics::scanWith<Rules>(level, to, input))
+            {
+                case Physics::Outcome::MOVED:
+                {
+                    size_t entry = platforms.entryOf(to.x, to.y + 1);
+                    target = entry == PlatformIndex::NONE ? STAY : static_cast<uint32_t>(entry);
+                    break;
+                }
+                case Physics::Outcome::DIED:
+                    target = DEAD;
+                    break;
+                case Physics::Outcome::NO_LADDER:
+                    target = NO_LADDER;
+                    break;
+                case Physics::Outcome::BLOCKED:
+                case Physics::Outcome::QUIT:
+                    target = STAY;
+                    break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Übernimmt die Einträge einer unveränderten Spalte aus der vorherigen Tabelle.
+ *
+ * Die Spalte und ihre Nachbarn haben dieselben Plattformen wie vorher, nur die
+ * Zellnummern sind verschoben, wenn sich links davon die Anzahl der Plattformen geändert hat.
+ */
+void TransitionTable::copyColumn(const Level& level, const Level& previous, size_t col)
+{
+    const auto& offsets = level.platforms.getOffsets();
+    const auto& oldOffsets = previous.platforms.getOffsets();
+    const TransitionTable& old = previous.transitions;
+
+    for (size_t cell = offsets[col]; cell < offsets[col + 1]; ++cell)
+    {
+        size_t oldCell = oldOffsets[col] + (cell - offsets[col]);
+        columns[cell] = static_cast<uint32_t>(col);
+
+        for (size_t inputSlot = 0; inputSlot < INPUTS; ++inputSlot)
+        {
+            uint32_t target = old.targets[oldCell * INPUTS + inputSlot];
+            if (target < NO_CELL)
+            {
+                uint32_t targetCol = old.columns[target];
+                target = offsets[targetCol] + (target - oldOffsets[targetCol]);
+            }
+            targets[cell * INPUTS + inputSlot] = target;
+        }
+    }
+}
+
+///@brief True, wenn die Tabelle noch nicht berechnet ist
+bool TransitionTable::empty() const
+{
+    return columns.empty();
+}
+
+///@brief Anzahl der Zellen
+size_t TransitionTable::size() const
+{
+    return columns.size();
+}